@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+var assert = require("assert");
+
+/// Bytes 0 to length - 1, varied so every index is used.
+function makeBuffer(length) {
+	var buffer = new Buffer(length);
+	for(var i = 0; i < length; ++i)
+		buffer.writeUint8((i * 37 + length) & 0xFF, i);
+	return buffer;
+}
+
+/// base64url is base64 with two other characters and no padding.
+function toBase64Url(base64) {
+	return base64.replace(/\+/g, "-").replace(/\//g, "_").replace(/=+$/, "");
+}
+
+// Lengths of 1 and 2 past a group are the only ones with a tail, and
+// past 12 the vectorized path is used.
+exports['test base64url length'] = function () {
+	for(var length = 0; length < 64; ++length) {
+		var string = makeBuffer(length).toString("base64url");
+
+		assert.equal(string.length, Math.floor(length / 3) * 4 + (length % 3 ? length % 3 + 1 : 0));
+		assert.equal(string.indexOf("="), -1);
+	}
+};
+
+exports['test base64url matches base64'] = function () {
+	for(var length = 0; length < 64; ++length) {
+		var buffer = makeBuffer(length);
+
+		assert.equal(buffer.toString("base64url"), toBase64Url(buffer.toString("base64")));
+	}
+};
+
+exports['test base64url round trip'] = function () {
+	for(var length = 0; length < 64; ++length) {
+		var buffer = makeBuffer(length);
+
+		assert.deepEqual(new Buffer(buffer.toString("base64url"), "base64url").toJSON(), buffer.toJSON());
+	}
+};
+
+exports['test base64url encoder tail'] = function () {
+	for(var length = 0; length < 16; ++length) {
+		var buffer = makeBuffer(length);
+		var encoder = Buffer.createEncoder("base64url");
+
+		assert.equal(encoder.end(buffer), buffer.toString("base64url"));
+	}
+};
+
+exports['test base64url decoder chunks'] = function () {
+	for(var length = 0; length < 40; ++length) {
+		var buffer = makeBuffer(length);
+		var string = buffer.toString("base64url");
+
+		// Every split, so groups are carried across writes and into end()
+		for(var split = 0; split <= string.length; ++split) {
+			var decoder = Buffer.createDecoder("base64url");
+			var first = decoder.write(string.slice(0, split));
+			var rest = decoder.end(string.slice(split));
+
+			assert.deepEqual(Buffer.concat([first, rest]).toJSON(), buffer.toJSON());
+		}
+	}
+};
+
+exports['test base64 decoder end'] = function () {
+	var decoder = Buffer.createDecoder("base64");
+
+	assert.equal(Buffer.createDecoder("base64").end("QUI").toString(), "AB");
+	assert.equal(decoder.write("QU").length, 0);
+	assert.equal(decoder.end("JD").toString(), "ABC");
+};
+
+exports['test base64 padding'] = function () {
+	assert.equal(new Buffer([0xFB]).toString("base64"), "+w==");
+	assert.equal(new Buffer([0xFB, 0xFF]).toString("base64"), "+/8=");
+	assert.equal(new Buffer([0xFB]).toString("base64url"), "-w");
+	assert.equal(new Buffer([0xFB, 0xFF]).toString("base64url"), "-_8");
+};
+
+if(module == require.main)
+	require("test").run(exports);
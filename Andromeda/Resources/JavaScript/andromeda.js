@@ -29,12 +29,43 @@
 
 	var vmBinding = engine.binding("vm");
 	var fsBinding = engine.binding("fs");
+	var bundleBinding = engine.binding("bundle");
 
 	/// JavaScript entry point of Andromeda
 	function start() {
 
-		// Load the Buffer class.
-		global.Buffer = Module._load("buffer", null);
+		// Build a module bundle instead of running the game.
+		var buildPath = bundleBinding.buildPath();
+		if(buildPath) {
+			Module._buildBundle(["main", "buffer"], buildPath);
+			return;
+		}
+
+		// Load the Buffer class when first used.
+		Object.defineProperty(global, "Buffer", {
+			get: function () {
+				var Buffer = Module._load("buffer", null);
+				Object.defineProperty(global, "Buffer", {
+					value: Buffer,
+					writable: true,
+					configurable: true
+				});
+				return Buffer;
+			},
+			configurable: true
+		});
+
+		// Load resources on background threads. The resource is only
+		// certain to stay cached until the promise has resolved: use it
+		// then, or it may be evicted and loaded again.
+		engine.loadAsync = function (path, options) {
+			return startLoad(function (priority, callback) {
+				return engine.binding("loader").load(path, priority, callback);
+			}, options);
+		};
+
+		// Reload modules when their files change.
+		engine.on("change", Module._reload);
 
 		// Load and execute the main module.
 		Module.runMain("main");
@@ -60,20 +91,39 @@
 	}
 
 	Module._cache = {};
-	//Module._pathCache = {};
+	Module._pathCache = {}; // parent dir + query -> filename
+	Module._packageMainCache = {}; // directory -> main of package.json
+
+	/// Extensions tried when the query has none.
+	Module._extensions = [".js", ".json"];
+
+	/// Directories searched for non-relative queries, after node_modules.
+	Module.globalPaths = [fsBinding.resourcePath()];
+
+	/// Item types returned by the stat of the fs and bundle bindings.
+	var STAT_FILE = 1;
+	var STAT_DIRECTORY = 2;
 
 	/// Loading a module.
 	Module.prototype.require = function (query) {
 		return Module._load(query, this);
 	};
 
-	/// Load this module by compiling it.
-	Module.prototype.load = function (filename) {
+	/// Load this module by compiling it. Reads the file, unless
+	/// the content is given.
+	Module.prototype.load = function (filename, content) {
 		//assert(!this.loaded);
 		this.filename = filename;
 
-		var content = fsBinding.readFile(filename, "utf8");
-		this._compile(content, filename);
+		if(content === undefined)
+			content = readModuleFile(filename);
+		if(content === null)
+			throw new Error("Can't read module '" + filename + "'");
+
+		if(filename.slice(-5) === ".json")
+			this.exports = JSON.parse(content);
+		else
+			this._compile(content, filename);
 
 		this.loaded = true;
 	};
@@ -103,12 +153,16 @@
 		}
 
 		require.resolve = function (query) {
-			return Module._resolveQuery(query, self);
+			return Module._resolveFilename(query, self);
 		};
-		
+
+		require.async = function (query, options) {
+			return Module._loadAsync(query, self, options);
+		};
+
 		require.main = engine.mainModule;
 
-		var dirname = "TODO";
+		var dirname = dirnameOf(filename);
 		var wrapped = Module.wrap(content);
 		var compiled = vmBinding.runInThisContext(wrapped, {
 			"filename": filename
@@ -123,10 +177,18 @@
 	/// Does resolving of paths.
 	Module._load = function (query, parent, isMain) {
 		var filename = Module._resolveFilename(query, parent);
+		return Module._loadFile(filename, parent, isMain);
+	};
 
+	/// Load a module with given filename, and optionally its content.
+	Module._loadFile = function (filename, parent, isMain, content) {
 		var module = Module._cache[filename];
-		if(module)
+		if(module) {
+			// Every module that requires it depends on it, for reloading.
+			if(parent && parent.children.indexOf(module) < 0)
+				parent.children.push(module);
 			return module.exports;
+		}
 
 		module = new Module(filename, parent);
 		if(isMain) {
@@ -138,7 +200,7 @@
 
 		var hadException = true;
 		try {
-			module.load(filename);
+			module.load(filename, content);
 			hadException = false;
 		} finally {
 			if(hadException)
@@ -148,6 +210,103 @@
 		return module.exports;
 	};
 
+	/// Load a module without blocking: the file is read on a background
+	/// thread, and the module is compiled when it arrives. Modules it
+	/// requires are loaded as usual.
+	/// Returns a promise of the exports, with cancel() and setPriority().
+	Module._loadAsync = function (query, parent, options) {
+		var filename;
+		try {
+			filename = Module._resolveFilename(query, parent);
+		} catch(e) {
+			return Promise.reject(e);
+		}
+
+		var loading;
+		if(Module._cache[filename] || bundleBinding.stat(filename) === STAT_FILE) {
+			// Already loaded, or in the mapped bundle: nothing to wait for.
+			loading = startLoad(function (priority, callback) {
+				engine.dispatch(function () {
+					callback(null, undefined);
+				});
+				return null;
+			}, options);
+		} else {
+			loading = startLoad(function (priority, callback) {
+				return engine.binding("loader").readFile(filename, priority, callback);
+			}, options);
+		}
+
+		var loaded = loading.then(function (content) {
+			return Module._loadFile(filename, parent, false, content);
+		});
+		loaded.cancel = loading.cancel;
+		loaded.setPriority = loading.setPriority;
+
+		return loaded;
+	};
+
+	/// Reload the modules of changed files, and the modules that
+	/// depend on them. The main module is not run again: the game
+	/// picks up new exports on the 'reload' event of the engine.
+	Module._reload = function (paths) {
+		var changed = paths.filter(function (path) {
+			return Module._cache[path];
+		});
+
+		// Added and removed files change what queries resolve to.
+		Module._clearPathCache();
+
+		if(changed.length === 0)
+			return;
+
+		var dependents = {};
+		Object.keys(Module._cache).forEach(function (filename) {
+			Module._cache[filename].children.forEach(function (child) {
+				(dependents[child.filename] = dependents[child.filename] || []).push(filename);
+			});
+		});
+
+		var stale = [];
+		var isStale = {};
+		(function markStale(filenames) {
+			filenames.forEach(function (filename) {
+				var module = Module._cache[filename];
+				if(isStale[filename] || !module || module === engine.mainModule)
+					return;
+
+				isStale[filename] = true;
+				stale.push(module);
+				markStale(dependents[filename] || []);
+			});
+		})(changed);
+
+		stale.forEach(function (module) {
+			delete Module._cache[module.filename];
+		});
+
+		// Forget the old modules, and load the new ones in their place.
+		Object.keys(Module._cache).forEach(function (filename) {
+			var module = Module._cache[filename];
+			module.children = module.children.filter(function (child) {
+				return !isStale[child.filename];
+			});
+		});
+
+		var reloaded = [];
+		stale.forEach(function (module) {
+			try {
+				Module._loadFile(module.filename, module.parent);
+				reloaded.push(module.filename);
+			} catch(e) {
+				console.log("Failed to reload '" + module.filename + "': " + e);
+				Module._cache[module.filename] = module;
+			}
+		});
+
+		engine.trigger("reload", [reloaded]);
+	};
+
 	/// Resolve a query to a filename.
 	Module._resolveFilename = function (query, parent) {
 		var filename = Module._resolveQuery(query, parent);
@@ -157,11 +316,271 @@
 		return filename;
 	};
 
-	/// Resolve the query
+	/// Resolve the query, or return null if there is no such module.
 	Module._resolveQuery = function (query, parent) {
-		return query + ".js"; // TODO
+		var parentDir = (parent && parent.filename) ? dirnameOf(parent.filename) : "";
+		var cacheKey = parentDir + "\0" + query;
+
+		var filename = Module._pathCache[cacheKey];
+		if(filename)
+			return filename;
+
+		if(isPathQuery(query)) {
+			var fromDir = parentDir || Module.globalPaths[0];
+			var base = query.charAt(0) === "/" ? query : fromDir + "/" + query;
+			filename = Module._tryPath(normalizePath(base));
+		} else {
+			var paths = Module._nodeModulePaths(parentDir).concat(Module.globalPaths);
+			for(var i = 0; i < paths.length && !filename; ++i)
+				filename = Module._tryPath(paths[i] + "/" + query);
+		}
+
+		if(filename)
+			Module._pathCache[cacheKey] = filename;
+		return filename;
 	};
 
+	/// Find the module file for a path: the file itself, with an
+	/// extension, or a package directory.
+	Module._tryPath = function (path) {
+		return Module._tryFile(path)
+			|| Module._tryExtensions(path)
+			|| Module._tryPackage(path);
+	};
+
+	Module._tryFile = function (path) {
+		return statPath(path) === STAT_FILE ? path : null;
+	};
+
+	Module._tryExtensions = function (path) {
+		for(var i = 0; i < Module._extensions.length; ++i) {
+			var filename = Module._tryFile(path + Module._extensions[i]);
+			if(filename)
+				return filename;
+		}
+		return null;
+	};
+
+	/// Find the module file of a directory: the main of its
+	/// package.json, or its index.
+	Module._tryPackage = function (path) {
+		if(statPath(path) !== STAT_DIRECTORY)
+			return null;
+
+		var main = Module._readPackageMain(path);
+		if(main) {
+			var base = normalizePath(path + "/" + main);
+			var filename = Module._tryFile(base)
+				|| Module._tryExtensions(base)
+				|| Module._tryExtensions(base + "/index");
+			if(filename)
+				return filename;
+		}
+
+		return Module._tryExtensions(path + "/index");
+	};
+
+	/// Get the main field of the package.json in a directory.
+	Module._readPackageMain = function (path) {
+		if(path in Module._packageMainCache)
+			return Module._packageMainCache[path];
+
+		var main = null;
+		var jsonPath = path + "/package.json";
+		if(statPath(jsonPath) === STAT_FILE) {
+			var content = readModuleFile(jsonPath);
+			try {
+				main = JSON.parse(content).main || null;
+			} catch(e) {
+				e.message = "Error parsing " + jsonPath + ": " + e.message;
+				throw e;
+			}
+		}
+
+		Module._packageMainCache[path] = main;
+		return main;
+	};
+
+	/// All node_modules directories from a directory up to the root.
+	Module._nodeModulePaths = function (from) {
+		var paths = [];
+
+		if(from.charAt(0) !== "/")
+			return paths;
+
+		var parts = from.split("/");
+		for(var i = parts.length; i > 0; --i) {
+			if(parts[i - 1] === "node_modules")
+				continue;
+
+			var dir = parts.slice(0, i).join("/");
+			paths.push(dir + "/node_modules");
+		}
+
+		return paths;
+	};
+
+	/// Forget all resolved paths, for when files have changed.
+	Module._clearPathCache = function () {
+		Module._pathCache = {};
+		Module._packageMainCache = {};
+		fsBinding.clearStatCache();
+	};
+
+	/**
+	 * @section Loading
+	 */
+
+	/// Priorities of loads, by name.
+	var PRIORITIES = { low: -4, normal: 0, high: 4 };
+
+	function priorityOf(priority) {
+		if(typeof priority === "number")
+			return priority;
+		return PRIORITIES[priority] || 0;
+	}
+
+	/// Start a load with the loader binding. Returns a promise of the
+	/// result, with cancel() and setPriority(priority).
+	/// Options: priority, "low", "normal", "high" or -4 to 4.
+	function startLoad(load, options) {
+		var request = null;
+		var rejectLoad;
+
+		var promise = new Promise(function (resolve, reject) {
+			rejectLoad = reject;
+			request = load(priorityOf(options && options.priority), function (error, result) {
+				if(error)
+					reject(new Error(error));
+				else
+					resolve(result);
+			});
+		});
+
+		promise.cancel = function () {
+			if(request)
+				request.cancel();
+
+			var error = new Error("Load cancelled");
+			error.cancelled = true;
+			rejectLoad(error);
+		};
+
+		promise.setPriority = function (priority) {
+			if(request)
+				request.priority = priorityOf(priority);
+		};
+
+		return promise;
+	}
+
+	/**
+	 * @section Bundles
+	 */
+
+	/// Matches require calls with a literal query.
+	var REQUIRE_PATTERN = /\brequire\s*\(\s*(["'])([^"'\n]+)\1\s*\)/g;
+
+	/// Write a bundle with all modules reachable from given modules.
+	Module._buildBundle = function (queries, path) {
+		var filenames = [];
+		var seen = {};
+		var pending = queries.map(function (query) {
+			return { query: query, parent: null };
+		});
+
+		while(pending.length > 0) {
+			var item = pending.pop();
+			var filename = Module._resolveQuery(item.query, item.parent);
+			if(!filename) {
+				console.log("Can't find module '" + item.query + "', not bundled");
+				continue;
+			}
+
+			if(seen[filename])
+				continue;
+			seen[filename] = true;
+			filenames.push(filename);
+
+			var content = readModuleFile(filename);
+			var parent = { filename: filename };
+			var match;
+
+			REQUIRE_PATTERN.lastIndex = 0;
+			while((match = REQUIRE_PATTERN.exec(content)) !== null)
+				pending.push({ query: match[2], parent: parent });
+		}
+
+		// Packages are resolved through their package.json
+		for(var dir in Module._packageMainCache) {
+			if(Module._packageMainCache[dir])
+				filenames.push(dir + "/package.json");
+		}
+
+		if(!bundleBinding.write(path, filenames))
+			throw new Error("Failed to write bundle '" + path + "'");
+	};
+
+	/// Type of a path: from the bundle if it has it, the file system otherwise.
+	function statPath(path) {
+		return bundleBinding.stat(path) || fsBinding.stat(path);
+	}
+
+	/// Contents of a module file: from the bundle if it has it, the file
+	/// system otherwise.
+	function readModuleFile(filename) {
+		var content = bundleBinding.read(filename);
+		if(content === null)
+			content = fsBinding.readFile(filename, "utf8");
+		return content;
+	}
+
+	/**
+	 * @section Paths
+	 */
+
+	/// Whether a query is a path instead of a module name.
+	function isPathQuery(query) {
+		return query.charAt(0) === "/"
+			|| query === "." || query === ".."
+			|| query.slice(0, 2) === "./"
+			|| query.slice(0, 3) === "../";
+	}
+
+	/// Remove '.', '..' and double separators from a path.
+	function normalizePath(path) {
+		var isAbsolute = path.charAt(0) === "/";
+		var parts = path.split("/");
+		var result = [];
+
+		for(var i = 0; i < parts.length; ++i) {
+			var part = parts[i];
+
+			if(part === "" || part === ".")
+				continue;
+
+			if(part === "..") {
+				if(result.length > 0 && result[result.length - 1] !== "..")
+					result.pop();
+				else if(!isAbsolute)
+					result.push(part);
+			} else
+				result.push(part);
+		}
+
+		return (isAbsolute ? "/" : "") + result.join("/");
+	}
+
+	/// The directory part of a path.
+	function dirnameOf(path) {
+		var index = path.lastIndexOf("/");
+		if(index < 0)
+			return ".";
+		if(index === 0)
+			return "/";
+		return path.slice(0, index);
+	}
+
 	// After loading all code, start!
 	start();
 });
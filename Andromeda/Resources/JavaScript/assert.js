@@ -116,9 +116,8 @@ function _deepEqual(actual, expected) {
 	if(actual === expected)
 		return true;
 
-	if(util.isBuffer(actual) && util.isBuffer(expected)) {
-
-	}
+	if(util.isBuffer(actual) && util.isBuffer(expected))
+		return actual.equals(expected);
 
 	// 7.2. If the expected value is a Date object, the actual value is equivalent
 	//      if it is also a Date object that refers to the same time.
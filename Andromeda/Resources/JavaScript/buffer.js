@@ -38,6 +38,9 @@ var abTools = engine.binding("arraybuffer");
  * - `([5,10])` Creates a buffer with length 2, with given data.
  * - `(5)` Creates a buffer with length 5.
  *
+ * The data lives in an ArrayBuffer. All methods are shared on the
+ * prototype, and bulk operations are done by the arraybuffer binding.
+ *
  * @constructor
  * @param {Number} subject - Size of the array
  *
@@ -47,482 +50,573 @@ var abTools = engine.binding("arraybuffer");
  * @param {String} [encoding=utf8] - String encoding.
  */
 function Buffer(subject, encoding) {
-	if(util.isNumber(subject)) {
-		this.length = subject > 0 ? subject >>> 0 : 0;
-		var array = new ArrayBuffer(this.length);
-	} else if(util.isString(subject)) {
-		encoding = encoding || "utf8";
-		var array = abTools.arrayBufferFromString(subject,encoding);
-	} else if(util.isArray(subject)) {
-		this.length = +subject.length > 0 ? Math.floor(+subject.length) : 0;
-
-		var array = new ArrayBuffer(this.length);
-		var view = new DataView(array);
-		for(var i = 0; i < this.length; ++i)
-			view.setUint8(i, subject[i]);
-	} else if(util.amd_isArrayBuffer(subject)) {
-		this.length = subject.length;
-		var array = subject;
-	} else
+	var array;
+
+	if(util.isNumber(subject))
+		array = new ArrayBuffer(subject > 0 ? subject >>> 0 : 0);
+	else if(util.isString(subject))
+		array = abTools.arrayBufferFromString(subject, encoding || "utf8");
+	else if(util.isArray(subject))
+		array = abTools.arrayBufferFromArray(subject);
+	else if(util.amd_isArrayBuffer(subject))
+		array = subject;
+	else if(util.isBuffer(subject))
+		array = subject._array.slice(0);
+	else
 		throw new TypeError("Buffer() arguments must start with number, buffer, array or string.");
 
-	var view = new DataView(array);
-
-	/**
-	 * Get the internal ArrayBuffer.
-	 *
-	 * @return {ArrayBuffer}
-	 */
-	this._getArrayBuffer = function () {
-		return array;
-	};
-
-	/**
-	 * Convert the data to a string.
-	 *
-	 * @param {String} [encoding=utf8] - String encoding.
-	 * @param {Number} [start=0] - Offset to start at.
-	 * @param {Number} [start=buffer.length] - End of the string.
-	 * @return {String} String of the buffer.
-	 */
-	this.toString = function (encoding, start, end) {
-		start = start >>> 0;
-		end = util.isUndefined(end) || end == Infinity ? this.length : end >>> 0;
-
-		encoding = encoding || "utf8";
-		if(start < 0)
-			start = 0;
-		if(end > this.length)
-			end = this.length;
-		if(end <= start)
-			return "";
-
-		return abTools.stringFromArrayBuffer(array, encoding, start, end);
-	};
-	
-	/**
-	 * Get a JSON representation of the buffer, usable with Buffer(Array).
-	 *
-	 * (new Buffer("test")).toJSON() == [116,101,115,116]
-	 *
-	 * @return {Array} Array of byte elements.
-	 */
-	this.toJSON = function () {
-	};
-	
-	/**
-	 * Write a string to the buffer.
-	 *
-	 * @param {String} string - The data to be written.
-	 * @param {Number} [offset=0] - The offset to start writing at.
-	 * @param {Number} [length=buffer.length-offset] - Length of the data to be written.
-	 * @param {String} [encoding=utf8] - Encoding of the string.
-	 */
-	this.write = function(string, offset, length, encoding) {	
-	};
-
-	/**
-	 * Copy data between buffers.
-	 *
-	 * @param {Buffer} targetBuffer - Buffer to copy to.
-	 * @param {Number} [targetStart=0] - Position to copy to.
-	 * @param {Number} [sourceStart=0] - Position to copy from.
-	 * @param {Number} [sourceEnd=buffer.length-sourceStart] - End of slice to copy from.
-	 * @return {Number} Number of bytes copied.
-	 */
-	this.copy = function(targetBuffer, targetStart, sourceStart, sourceEnd) {
-		if(!util.isBuffer(targetBuffer))
-			throw new TypeError("First argument of Buffer.copy() must be a Buffer.");
-
-		targetStart = targetStart >>> 0;
-		sourceStart = sourceStart >>> 0;
-		sourceEnd = sourceEnd || this.length - sourceStart;
-		var targetLength = targetBuffer.length;
-
-		if(targetStart < 0 || targetStart > targetLength)
-			throw new RangeError("targetStart is out of range.");
-		if(sourceStart < 0 || sourceStart > this.length)
-			throw new RangeError("sourceStart is out of range.");
-		if(sourceEnd > this.length)
-			throw new RangeError("sourceEnd is out of range.");
-
-		if(targetStart >= targetLength || sourceStart >= sourceEnd)
-			return 0;
-
-		if(sourceEnd - sourceStart > targetLength - targetStart)
-			sourceEnd = targetLength - targetStart + sourceStart;
-
-		return abTools.copy(array,sourceStart,sourceEnd,
-							targetBuffer._getArrayBuffer(),targetStart);
-	};
-
-	/**
-	 * Create a new buffer with the slice of this buffer.
-	 *
-	 * @param {Number} [start=0] - Start of the buffer.
-	 * @param {Number} [end=length-offset] - End of the buffer.
-	 * @return {Buffer} Buffer with the slice.
-	 */
-	this.slice = function(start,end) {
-		var slicedArray = array.slice(start >>> 0, end);
-		return new Buffer(slicedArray);
-	};
-	
-	/**
-	 * Fill (a part of) the buffer with specified value.
-	 *
-	 * @param value - Value to fill with.
-	 * @param {Number} [offset=0] - Offset to start the filling.
-	 * @param {Number} [end=length-offset] - End of the filling.
-	 */
-	this.fill = function(value, offset, end) {
-		offset = offset >>> 0;
-		end = end || this.length - offset;
-		
-		if(end > this.length)
-			throw new RangeError("Range must be within buffer.");
-		
-		for(var i = offset; i < end; ++i)
-			view.setUint8(i, value);
-	};
-
-	/**
-	 * Read an unsigned 8bit numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readUint8 = function(offset) {
-		if(offset < 0 || offset > this.length-1)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getUint8(offset);
-	};
-
-	/**
-	 * Read an unsigned 16 bit least endian numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readUint16LE = function(offset) {
-		if(offset < 0 || offset > this.length-2)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getUint16(offset,true);
-	};
-
-	/**
-	 * Read an unsigned 16 bit big endian numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readUint16BE = function(offset) {
-		if(offset < 0 || offset > this.length-2)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getUint16(offset,false);
-	};
-
-	/**
-	 * Read an unsigned 32 bit least endian numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readUint32LE = function(offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getUint32(offset,true);
-	};
-
-	/**
-	 * Read an unsigned 32 bit big endian numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readUint32BE = function(offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getUint32(offset,false);
-	};
-
-	/**
-	 * Read a signed 8bit numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readInt8 = function(offset) {
-		if(offset < 0 || offset > this.length-1)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getInt8(offset);
-	};
-
-	/**
-	 * Read a signed 16 bit least endian numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readInt16LE = function(offset) {
-		if(offset < 0 || offset > this.length-2)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getInt16(offset,true);
-	};
-
-	/**
-	 * Read a signed 16 bit big endian numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readInt16BE = function(offset) {
-		if(offset < 0 || offset > this.length-2)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getInt16(offset,false);
-	};
-
-	/**
-	 * Read a signed 32 bit least endian numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readInt32LE = function(offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getInt32(offset,true);
-	};
-
-	/**
-	 * Read a signed 32 bit big endian numeric value from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readInt32BE = function(offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getInt32(offset,false);
-	};
-
-	/**
-	 * Read a 32 bit least endian float from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readFloatLE = function(offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getFloat32(offset,true);
-	};
-
-	/**
-	 * Read a 32 bit big endian float from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readFloatBE = function(offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getFloat32(offset,false);
-	};
-
-	/**
-	 * Read a 64 bit least endian double from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readDoubleLE = function(offset) {
-		if(offset < 0 || offset > this.length-8)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getFloat64(offset,true);
-	};
-
-	/**
-	 * Read a 64 bit big endian double from the buffer.
-	 *
-	 * @param {Number} offset - Offset to read at.
-	 * @return {Number} The value.
-	 */
-	this.readDoubleBE = function(offset) {
-		if(offset < 0 || offset > this.length-8)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.getFloat64(offset,false);
-	};
-
-	/**
-	 * Write an unsigned 8bit numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeUint8 = function(value, offset) {
-		if(offset < 0 || offset > this.length-1)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setUint8(offset, value);
-	};
-
-	/**
-	 * Write an unsigned 16 bit least endian numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeUint16LE = function(value, offset) {
-		if(offset < 0 || offset > this.length-2)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setUint16(offset, value, true);
-	};
-
-	/**
-	 * Write an unsigned 16 bit big endian numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeUint16BE = function(value, offset) {
-		if(offset < 0 || offset > this.length-2)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setUint16(offset, value, false);
-	};
-
-	/**
-	 * Write an unsigned 32 bit least endian numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeUint32LE = function(value, offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setUint32(offset, value, true);
-	};
-
-	/**
-	 * Write an unsigned 32 bit big endian numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeUint32BE = function(value, offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setUint32(offset, value, false);
-	};
-
-	/**
-	 * Write a signed 8bit numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeInt8 = function(value, offset) {
-		if(offset < 0 || offset > this.length-1)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setInt8(offset, value);
-	};
-
-	/**
-	 * Write a signed 16 bit least endian numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeInt16LE = function(value, offset) {
-		if(offset < 0 || offset > this.length-2)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setInt16(offset, value, true);
-	};
-
-	/**
-	 * Write a signed 16 bit big endian numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeInt16BE = function(value, offset) {
-		if(offset < 0 || offset > this.length-2)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setInt16(offset, value, false);
-	};
-
-	/**
-	 * Write a signed 32 bit least endian numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeInt32LE = function(value, offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setInt32(offset, value, true);
-	};
-
-	/**
-	 * Write a signed 32 bit big endian numeric value to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeInt32BE = function(value, offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setInt32(offset, value, false);
-	};
-
-	/**
-	 * Write a 32 bit least endian float to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeFloatLE = function(value, offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setFloat32(offset, value, true);
-	};
-
-	/**
-	 * Write a 32 bit big endian float to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeFloatBE = function(value, offset) {
-		if(offset < 0 || offset > this.length-4)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setFloat32(offset, value, false);
-	};
-
-	/**
-	 * Write a 64 bit least endian double to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeDoubleLE = function(value, offset) {
-		if(offset < 0 || offset > this.length-8)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setFloat64(offset, value, true);
-	};
-
-	/**
-	 * Write a 64 bit big endian double to the buffer.
-	 *
-	 * @param {Number} value - Value to write.
-	 * @param {Number} offset - Offset to write to.
-	 */
-	this.writeDoubleBE = function(value, offset) {
-		if(offset < 0 || offset > this.length-8)
-			throw new RangeError("Offset must be within buffer range.");
-		return view.setFloat64(offset, value, false);
-	};
+	if(!array)
+		throw new TypeError("Unable to encode string as " + encoding + ".");
+
+	this._array = array;
+	this._view = new DataView(array);
+	this.length = array.byteLength;
 }
 
+/**
+ * Get the internal ArrayBuffer.
+ *
+ * @return {ArrayBuffer}
+ */
+Buffer.prototype._getArrayBuffer = function () {
+	return this._array;
+};
+
+/**
+ * Convert the data to a string.
+ *
+ * @param {String} [encoding=utf8] - String encoding.
+ * @param {Number} [start=0] - Offset to start at.
+ * @param {Number} [start=buffer.length] - End of the string.
+ * @return {String} String of the buffer.
+ */
+Buffer.prototype.toString = function (encoding, start, end) {
+	start = start >>> 0;
+	end = util.isUndefined(end) || end == Infinity ? this.length : end >>> 0;
+
+	encoding = encoding || "utf8";
+	if(end > this.length)
+		end = this.length;
+	if(end <= start)
+		return "";
+
+	return abTools.stringFromArrayBuffer(this._array, encoding, start, end);
+};
+
+/**
+ * Get a JSON representation of the buffer, usable with Buffer(Array).
+ *
+ * (new Buffer("test")).toJSON() == [116,101,115,116]
+ *
+ * @return {Array} Array of byte elements.
+ */
+Buffer.prototype.toJSON = function () {
+	return abTools.arrayFromArrayBuffer(this._array, 0, this.length);
+};
+
+/**
+ * Write a string to the buffer.
+ *
+ * Only whole characters are written. The encoding can also be given
+ * in place of the offset or length.
+ *
+ * @param {String} string - The data to be written.
+ * @param {Number} [offset=0] - The offset to start writing at.
+ * @param {Number} [length=buffer.length-offset] - Length of the data to be written.
+ * @param {String} [encoding=utf8] - Encoding of the string.
+ * @return {Number} Number of bytes written.
+ */
+Buffer.prototype.write = function(string, offset, length, encoding) {
+	if(!util.isString(string))
+		throw new TypeError("First argument of Buffer.write() must be a string.");
+
+	if(util.isString(offset)) {
+		encoding = offset;
+		offset = 0;
+		length = undefined;
+	} else if(util.isString(length)) {
+		encoding = length;
+		length = undefined;
+	}
+
+	offset = offset >>> 0;
+	if(offset > this.length)
+		throw new RangeError("offset is out of range.");
+
+	length = util.isUndefined(length) ? this.length - offset : length >>> 0;
+
+	return abTools.write(string, encoding || "utf8", this._array, offset, length);
+};
+
+/**
+ * Copy data between buffers.
+ *
+ * @param {Buffer} targetBuffer - Buffer to copy to.
+ * @param {Number} [targetStart=0] - Position to copy to.
+ * @param {Number} [sourceStart=0] - Position to copy from.
+ * @param {Number} [sourceEnd=buffer.length] - End of slice to copy from.
+ * @return {Number} Number of bytes copied.
+ */
+Buffer.prototype.copy = function(targetBuffer, targetStart, sourceStart, sourceEnd) {
+	if(!util.isBuffer(targetBuffer))
+		throw new TypeError("First argument of Buffer.copy() must be a Buffer.");
+
+	targetStart = targetStart >>> 0;
+	sourceStart = sourceStart >>> 0;
+	sourceEnd = util.isUndefined(sourceEnd) ? this.length : sourceEnd >>> 0;
+	var targetLength = targetBuffer.length;
+
+	if(targetStart > targetLength)
+		throw new RangeError("targetStart is out of range.");
+	if(sourceStart > this.length)
+		throw new RangeError("sourceStart is out of range.");
+	if(sourceEnd > this.length)
+		throw new RangeError("sourceEnd is out of range.");
+
+	if(targetStart >= targetLength || sourceStart >= sourceEnd)
+		return 0;
+
+	return abTools.copy(this._array, sourceStart, sourceEnd,
+						targetBuffer._array, targetStart);
+};
+
+/**
+ * Create a new buffer with the slice of this buffer.
+ *
+ * @param {Number} [start=0] - Start of the buffer.
+ * @param {Number} [end=length-offset] - End of the buffer.
+ * @return {Buffer} Buffer with the slice.
+ */
+Buffer.prototype.slice = function(start,end) {
+	var slicedArray = this._array.slice(start >>> 0, end);
+	return new Buffer(slicedArray);
+};
+
+/**
+ * Fill (a part of) the buffer with specified value.
+ *
+ * A string or buffer value is repeated over the range.
+ *
+ * @param {Number|String|Buffer} value - Value to fill with.
+ * @param {Number} [offset=0] - Offset to start the filling.
+ * @param {Number} [end=buffer.length] - End of the filling.
+ * @return {Buffer} The buffer.
+ */
+Buffer.prototype.fill = function(value, offset, end) {
+	offset = offset >>> 0;
+	end = util.isUndefined(end) ? this.length : end >>> 0;
+
+	if(end > this.length || offset > end)
+		throw new RangeError("Range must be within buffer.");
+
+	if(util.isNumber(value))
+		abTools.fill(this._array, value, offset, end);
+	else if(util.isString(value))
+		abTools.fillPattern(this._array, abTools.arrayBufferFromString(value, "utf8"), offset, end);
+	else if(util.isBuffer(value))
+		abTools.fillPattern(this._array, value._array, offset, end);
+	else
+		throw new TypeError("value must be a number, string or buffer.");
+
+	return this;
+};
+
+/**
+ * Compare the buffer with another buffer, bytewise.
+ *
+ * @param {Buffer} otherBuffer - Buffer to compare with.
+ * @return {Number} -1, 0 or 1 when this buffer sorts before, equal
+ * to or after the other buffer.
+ */
+Buffer.prototype.compare = function(otherBuffer) {
+	if(!util.isBuffer(otherBuffer))
+		throw new TypeError("Argument of Buffer.compare() must be a Buffer.");
+
+	return abTools.compare(this._array, 0, this.length,
+						   otherBuffer._array, 0, otherBuffer.length);
+};
+
+/**
+ * Get whether the buffer has the same bytes as another buffer.
+ *
+ * @param {Buffer} otherBuffer - Buffer to compare with.
+ * @return {Boolean} true if the bytes are equal.
+ */
+Buffer.prototype.equals = function(otherBuffer) {
+	return this.compare(otherBuffer) === 0;
+};
+
+/**
+ * Find the first occurrence of a value in the buffer.
+ *
+ * @param {Number|String|Buffer} value - Byte, string or bytes to search for.
+ * @param {Number} [byteOffset=0] - Offset to start searching at.
+ * @param {String} [encoding=utf8] - Encoding of a string value.
+ * @return {Number} Offset of the value, or -1 if it is not found.
+ */
+Buffer.prototype.indexOf = function(value, byteOffset, encoding) {
+	byteOffset = byteOffset >>> 0;
+
+	if(util.isNumber(value))
+		return abTools.indexOf(value, this._array, byteOffset, this.length);
+	if(util.isString(value))
+		value = new Buffer(value, encoding);
+	if(!util.isBuffer(value))
+		throw new TypeError("value must be a number, string or buffer.");
+
+	return abTools.indexOfBytes(value._array, this._array, byteOffset, this.length);
+};
+
+/**
+ * Read an unsigned 8bit numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readUint8 = function(offset) {
+	if(offset < 0 || offset > this.length-1)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getUint8(offset);
+};
+
+/**
+ * Read an unsigned 16 bit least endian numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readUint16LE = function(offset) {
+	if(offset < 0 || offset > this.length-2)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getUint16(offset,true);
+};
+
+/**
+ * Read an unsigned 16 bit big endian numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readUint16BE = function(offset) {
+	if(offset < 0 || offset > this.length-2)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getUint16(offset,false);
+};
+
+/**
+ * Read an unsigned 32 bit least endian numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readUint32LE = function(offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getUint32(offset,true);
+};
+
+/**
+ * Read an unsigned 32 bit big endian numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readUint32BE = function(offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getUint32(offset,false);
+};
+
+/**
+ * Read a signed 8bit numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readInt8 = function(offset) {
+	if(offset < 0 || offset > this.length-1)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getInt8(offset);
+};
+
+/**
+ * Read a signed 16 bit least endian numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readInt16LE = function(offset) {
+	if(offset < 0 || offset > this.length-2)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getInt16(offset,true);
+};
+
+/**
+ * Read a signed 16 bit big endian numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readInt16BE = function(offset) {
+	if(offset < 0 || offset > this.length-2)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getInt16(offset,false);
+};
+
+/**
+ * Read a signed 32 bit least endian numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readInt32LE = function(offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getInt32(offset,true);
+};
+
+/**
+ * Read a signed 32 bit big endian numeric value from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readInt32BE = function(offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getInt32(offset,false);
+};
+
+/**
+ * Read a 32 bit least endian float from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readFloatLE = function(offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getFloat32(offset,true);
+};
+
+/**
+ * Read a 32 bit big endian float from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readFloatBE = function(offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getFloat32(offset,false);
+};
+
+/**
+ * Read a 64 bit least endian double from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readDoubleLE = function(offset) {
+	if(offset < 0 || offset > this.length-8)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getFloat64(offset,true);
+};
+
+/**
+ * Read a 64 bit big endian double from the buffer.
+ *
+ * @param {Number} offset - Offset to read at.
+ * @return {Number} The value.
+ */
+Buffer.prototype.readDoubleBE = function(offset) {
+	if(offset < 0 || offset > this.length-8)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.getFloat64(offset,false);
+};
+
+/**
+ * Write an unsigned 8bit numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeUint8 = function(value, offset) {
+	if(offset < 0 || offset > this.length-1)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setUint8(offset, value);
+};
+
+/**
+ * Write an unsigned 16 bit least endian numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeUint16LE = function(value, offset) {
+	if(offset < 0 || offset > this.length-2)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setUint16(offset, value, true);
+};
+
+/**
+ * Write an unsigned 16 bit big endian numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeUint16BE = function(value, offset) {
+	if(offset < 0 || offset > this.length-2)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setUint16(offset, value, false);
+};
+
+/**
+ * Write an unsigned 32 bit least endian numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeUint32LE = function(value, offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setUint32(offset, value, true);
+};
+
+/**
+ * Write an unsigned 32 bit big endian numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeUint32BE = function(value, offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setUint32(offset, value, false);
+};
+
+/**
+ * Write a signed 8bit numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeInt8 = function(value, offset) {
+	if(offset < 0 || offset > this.length-1)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setInt8(offset, value);
+};
+
+/**
+ * Write a signed 16 bit least endian numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeInt16LE = function(value, offset) {
+	if(offset < 0 || offset > this.length-2)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setInt16(offset, value, true);
+};
+
+/**
+ * Write a signed 16 bit big endian numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeInt16BE = function(value, offset) {
+	if(offset < 0 || offset > this.length-2)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setInt16(offset, value, false);
+};
+
+/**
+ * Write a signed 32 bit least endian numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeInt32LE = function(value, offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setInt32(offset, value, true);
+};
+
+/**
+ * Write a signed 32 bit big endian numeric value to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeInt32BE = function(value, offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setInt32(offset, value, false);
+};
+
+/**
+ * Write a 32 bit least endian float to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeFloatLE = function(value, offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setFloat32(offset, value, true);
+};
+
+/**
+ * Write a 32 bit big endian float to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeFloatBE = function(value, offset) {
+	if(offset < 0 || offset > this.length-4)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setFloat32(offset, value, false);
+};
+
+/**
+ * Write a 64 bit least endian double to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeDoubleLE = function(value, offset) {
+	if(offset < 0 || offset > this.length-8)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setFloat64(offset, value, true);
+};
+
+/**
+ * Write a 64 bit big endian double to the buffer.
+ *
+ * @param {Number} value - Value to write.
+ * @param {Number} offset - Offset to write to.
+ */
+Buffer.prototype.writeDoubleBE = function(value, offset) {
+	if(offset < 0 || offset > this.length-8)
+		throw new RangeError("Offset must be within buffer range.");
+	return this._view.setFloat64(offset, value, false);
+};
+
+/**
+ * Compare two buffers, bytewise. Usable with Array.sort().
+ *
+ * @param {Buffer} a - First buffer.
+ * @param {Buffer} b - Second buffer.
+ * @return {Number} -1, 0 or 1.
+ */
+Buffer.compare = function(a, b) {
+	if(!util.isBuffer(a) || !util.isBuffer(b))
+		throw new TypeError("Arguments of Buffer.compare() must be buffers.");
+
+	return a.compare(b);
+};
+
 /**
  * Concatenate multiple buffers into a new buffer.
  *
@@ -540,8 +634,6 @@ function Buffer(subject, encoding) {
  * @param {Number} [length] - Length of the new buffer.
  */
 Buffer.concat = function(list, length) {
-	var length = 0;
-
 	if(!util.isArray(list))
 		throw new TypeError("Buffer.concat() argument must start with an array.");
 
@@ -551,6 +643,7 @@ Buffer.concat = function(list, length) {
 		return list[0];
 
 	if(util.isUndefined(length)) {
+		length = 0;
 		for(var i = 0; i < list.length; ++i)
 			length += list[i].length;
 	} else
@@ -559,12 +652,103 @@ Buffer.concat = function(list, length) {
 	var buffer = new Buffer(length);
 	var position = 0;
 
-	for(var i = 0; i < list.length; ++i) {
-		list[i].copy(buffer, position);
-		position += list[i].length;
-	}
+	for(var i = 0; i < list.length && position < length; ++i)
+		position += list[i].copy(buffer, position);
 
 	return buffer;
 };
 
+/**
+ * Encodes buffers into strings in chunks.
+ *
+ * Bytes that do not fill a base64 group are kept until the next write.
+ *
+ * @constructor
+ * @param {String} encoding - base64, base64url or hex.
+ */
+function BufferEncoder(encoding) {
+	this._encoder = abTools.createEncoder(encoding);
+}
+
+/**
+ * Encode a chunk.
+ *
+ * @param {Buffer} buffer - The chunk.
+ * @return {String} The characters that are complete.
+ */
+BufferEncoder.prototype.write = function(buffer) {
+	if(!util.isBuffer(buffer))
+		throw new TypeError("Argument of BufferEncoder.write() must be a Buffer.");
+
+	return this._encoder.write(buffer._array, 0, buffer.length);
+};
+
+/**
+ * Finish encoding.
+ *
+ * @param {Buffer} [buffer] - A last chunk.
+ * @return {String} The remaining characters.
+ */
+BufferEncoder.prototype.end = function(buffer) {
+	var string = buffer ? this.write(buffer) : "";
+	return string + this._encoder.end();
+};
+
+/**
+ * Decodes strings into buffers in chunks.
+ *
+ * Characters that do not fill a group are kept until the next write.
+ *
+ * @constructor
+ * @param {String} encoding - base64, base64url or hex.
+ */
+function BufferDecoder(encoding) {
+	this._decoder = abTools.createDecoder(encoding);
+}
+
+/**
+ * Decode a chunk.
+ *
+ * @param {String} string - The chunk.
+ * @return {Buffer} The bytes that are complete.
+ */
+BufferDecoder.prototype.write = function(string) {
+	return new Buffer(this._decoder.write(String(string)));
+};
+
+/**
+ * Finish decoding.
+ *
+ * @param {String} [string] - A last chunk.
+ * @return {Buffer} The remaining bytes.
+ */
+BufferDecoder.prototype.end = function(string) {
+	var buffer = util.isUndefined(string) ? null : this.write(string);
+	var last = new Buffer(this._decoder.end());
+
+	if(!buffer)
+		return last;
+	return Buffer.concat([buffer, last]);
+};
+
+/**
+ * Create an encoder, for data that is too large to encode at once.
+ *
+ * @param {String} encoding - base64, base64url or hex.
+ * @return {BufferEncoder}
+ */
+Buffer.createEncoder = function(encoding) {
+	return new BufferEncoder(encoding);
+};
+
+/**
+ * Create a decoder, for data that is too large to decode at once.
+ *
+ * @param {String} encoding - base64, base64url or hex.
+ * @return {BufferDecoder}
+ */
+Buffer.createDecoder = function(encoding) {
+	return new BufferDecoder(encoding);
+};
+
 module.exports = Buffer;
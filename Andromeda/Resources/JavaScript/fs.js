@@ -29,6 +29,7 @@
 
 "use strict";
 
+var util = require("util");
 var fs = engine.binding("fs");
 var path = engine.binding("path");
 var hashing = engine.binding("hashing");
@@ -71,6 +72,23 @@ exports.sha256 = function (path) {
 	return hashing.fileHash(path, "sha256");
 };
 
+/// Read a whole file. Returns a string with an encoding, a Buffer
+/// without one, or null on failure.
+exports.readFile = function (path, encoding) {
+	if(encoding)
+		return fs.readFile(path, encoding);
+
+	var data = fs.readFile(path, "bin");
+	return data ? new Buffer(data) : null;
+};
+
+/// Write a string or Buffer to a file, replacing its contents.
+exports.writeFile = function (path, data, encoding) {
+	if(util.isBuffer(data))
+		data = data._getArrayBuffer();
+	return fs.writeFile(path, data, encoding || "utf8");
+};
+
 /**
  * @section Directory
  */
@@ -194,4 +212,681 @@ exports.File = File;
 
 /**
  * @section RawFile
- */
\ No newline at end of file
+ */
+
+/**
+ * Get the native position argument for a position.
+ *
+ * @param {Number} [position] - Position in the file.
+ * @return {Number} The position, or -1 for the current position.
+ */
+function filePosition(position) {
+	return util.isNumber(position) && position >= 0 ? position : -1;
+}
+
+/**
+ * A file that is read and written in parts, at any position.
+ *
+ * All functions run on a background I/O thread in the order they were
+ * called, so synchronous and asynchronous calls can be mixed. The
+ * asynchronous functions call back with (error, result).
+ *
+ * @constructor
+ * @param {String} path - Path of the file.
+ * @param {String} [flags=r] - r, r+, w, w+, a or a+, like fopen().
+ * @throws {Error} If the file can not be opened.
+ */
+function RawFile(path, flags) {
+	this.path = path;
+	this._handle = fs.open(path, flags || "r");
+	if(!this._handle)
+		throw new Error("Unable to open '" + path + "'.");
+}
+
+/**
+ * Size of the file in bytes.
+ */
+Object.defineProperty(RawFile.prototype, "size", {
+	get: function () {
+		return this._handle.size;
+	}
+});
+
+/**
+ * Read from the file into a buffer.
+ *
+ * @param {Buffer} buffer - Buffer to read into.
+ * @param {Number} [offset=0] - Offset in the buffer.
+ * @param {Number} [length=buffer.length-offset] - Maximum number of bytes.
+ * @param {Number} [position] - Position in the file. Reads at the
+ * current position when omitted.
+ * @return {Number} Number of bytes read, 0 at the end of the file.
+ */
+RawFile.prototype.read = function (buffer, offset, length, position) {
+	offset = offset >>> 0;
+	length = util.isUndefined(length) ? buffer.length - offset : length >>> 0;
+
+	return this._handle.read(buffer._getArrayBuffer(), offset, length, filePosition(position));
+};
+
+/**
+ * Write from a buffer to the file.
+ *
+ * @param {Buffer} buffer - Buffer to write from.
+ * @param {Number} [offset=0] - Offset in the buffer.
+ * @param {Number} [length=buffer.length-offset] - Number of bytes.
+ * @param {Number} [position] - Position in the file. Writes at the
+ * current position when omitted.
+ * @return {Number} Number of bytes written.
+ */
+RawFile.prototype.write = function (buffer, offset, length, position) {
+	offset = offset >>> 0;
+	length = util.isUndefined(length) ? buffer.length - offset : length >>> 0;
+
+	return this._handle.write(buffer._getArrayBuffer(), offset, length, filePosition(position));
+};
+
+/**
+ * Read from the file in the background.
+ *
+ * @param {Number} length - Maximum number of bytes.
+ * @param {Number} [position] - Position in the file.
+ * @param {Function} callback - Called with (error, buffer). The buffer
+ * is empty at the end of the file.
+ */
+RawFile.prototype.readAsync = function (length, position, callback) {
+	this._handle.readAsync(length >>> 0, filePosition(position), function (error, data) {
+		if(error)
+			callback(new Error(error));
+		else
+			callback(null, new Buffer(data));
+	});
+};
+
+/**
+ * Write a buffer to the file in the background.
+ *
+ * The buffer can be changed right after the call.
+ *
+ * @param {Buffer} buffer - The data.
+ * @param {Number} [position] - Position in the file.
+ * @param {Function} [callback] - Called with (error, bytesWritten).
+ */
+RawFile.prototype.writeAsync = function (buffer, position, callback) {
+	this._handle.writeAsync(buffer._getArrayBuffer(), 0, buffer.length, filePosition(position),
+							function (error, written) {
+		if(callback)
+			callback(error ? new Error(error) : null, written);
+	});
+};
+
+/**
+ * Write pending changes to the disk.
+ */
+RawFile.prototype.sync = function () {
+	this._handle.sync();
+};
+
+/**
+ * Close the file, after its pending background operations.
+ *
+ * @param {Function} [callback] - Called with (error) when closed.
+ */
+RawFile.prototype.close = function (callback) {
+	this._handle.close(function (error) {
+		if(callback)
+			callback(error ? new Error(error) : null);
+	});
+};
+
+exports.RawFile = RawFile;
+
+/// Open a file. See RawFile.
+exports.open = function (path, flags) {
+	return new RawFile(path, flags);
+};
+
+/**
+ * @section Streams
+ */
+
+/**
+ * Base of the file streams: sends events to listeners.
+ *
+ * @constructor
+ */
+function Stream() {
+	this._listeners = {};
+}
+
+/**
+ * Add a listener for an event.
+ *
+ * @param {String} event - The event.
+ * @param {Function} listener - The listener.
+ * @return {Stream} The stream.
+ */
+Stream.prototype.on = function (event, listener) {
+	if(!this._listeners[event])
+		this._listeners[event] = [];
+	this._listeners[event].push(listener);
+
+	return this;
+};
+
+/**
+ * Add a listener that is removed after its first call.
+ *
+ * @param {String} event - The event.
+ * @param {Function} listener - The listener.
+ * @return {Stream} The stream.
+ */
+Stream.prototype.once = function (event, listener) {
+	var self = this;
+
+	function onceListener() {
+		self.off(event, onceListener);
+		listener.apply(self, arguments);
+	}
+	onceListener.listener = listener;
+
+	return this.on(event, onceListener);
+};
+
+/**
+ * Remove a listener.
+ *
+ * @param {String} event - The event.
+ * @param {Function} listener - The listener.
+ * @return {Stream} The stream.
+ */
+Stream.prototype.off = function (event, listener) {
+	var listeners = this._listeners[event];
+
+	if(listeners) {
+		this._listeners[event] = listeners.filter(function (other) {
+			return other !== listener && other.listener !== listener;
+		});
+	}
+
+	return this;
+};
+
+/**
+ * Send an event to its listeners. Unhandled errors are thrown.
+ *
+ * @param {String} event - The event.
+ * @return {Boolean} Whether the event had listeners.
+ */
+Stream.prototype.emit = function (event) {
+	var listeners = this._listeners[event];
+	var args = Array.prototype.slice.call(arguments, 1);
+
+	if(!listeners || listeners.length === 0) {
+		if(event === "error")
+			throw args[0];
+		return false;
+	}
+
+	listeners.slice().forEach(function (listener) {
+		listener.apply(this, args);
+	}, this);
+
+	return true;
+};
+
+/**
+ * Turns chunks of bytes into strings, keeping characters whole.
+ *
+ * @constructor
+ * @param {String} encoding - The encoding.
+ */
+function ChunkDecoder(encoding) {
+	this.encoding = encoding;
+	this._rest = null;
+
+	if(encoding === "base64" || encoding === "base64url" || encoding === "hex")
+		this._encoder = Buffer.createEncoder(encoding);
+}
+
+/**
+ * Decode a chunk.
+ *
+ * @param {Buffer} chunk - The bytes.
+ * @return {String} The complete characters.
+ */
+ChunkDecoder.prototype.write = function (chunk) {
+	if(this._encoder)
+		return this._encoder.write(chunk);
+
+	if(this._rest) {
+		chunk = Buffer.concat([this._rest, chunk]);
+		this._rest = null;
+	}
+
+	// Later chunks have no byte order mark: decode them all in the
+	// order of the first. Without a mark, UTF-16 is big-endian.
+	if(this.encoding === "utf16") {
+		if(chunk.length < 2) {
+			this._rest = chunk;
+			return "";
+		}
+
+		var mark = chunk.readUint16BE(0);
+		this.encoding = mark === 0xFFFE ? "utf16le" : "utf16be";
+		if(mark === 0xFEFF || mark === 0xFFFE)
+			chunk = chunk.slice(2, chunk.length);
+	}
+
+	var complete = chunk.length;
+	if(this.encoding === "utf8")
+		complete = utf8CompleteLength(chunk);
+	else if(this.encoding === "utf16le" || this.encoding === "utf16be")
+		complete = utf16CompleteLength(chunk, this.encoding === "utf16le");
+
+	if(complete < chunk.length) {
+		this._rest = chunk.slice(complete, chunk.length);
+		chunk = chunk.slice(0, complete);
+	}
+
+	return chunk.toString(this.encoding);
+};
+
+/**
+ * Decode what is left.
+ *
+ * @return {String} The last characters.
+ */
+ChunkDecoder.prototype.end = function () {
+	if(this._encoder)
+		return this._encoder.end();
+
+	var rest = this._rest;
+	this._rest = null;
+
+	if(!rest)
+		return "";
+
+	// Half a UTF-16 code unit cannot be decoded
+	if(this.encoding.indexOf("utf16") === 0 && rest.length % 2)
+		return rest.slice(0, rest.length - 1).toString(this.encoding) + "\uFFFD";
+
+	return rest.toString(this.encoding);
+};
+
+/**
+ * Get the length of a UTF-8 chunk without an incomplete character at
+ * its end.
+ *
+ * @param {Buffer} chunk - The bytes.
+ * @return {Number} The length.
+ */
+function utf8CompleteLength(chunk) {
+	var length = chunk.length;
+
+	// Look back at most 3 bytes for the lead byte of the last character
+	for(var i = length - 1; i >= 0 && i >= length - 3; --i) {
+		var byte = chunk.readUint8(i);
+
+		if((byte & 0xC0) === 0x80)
+			continue;
+
+		var needed = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : byte >= 0xC0 ? 2 : 1;
+		return length - i >= needed ? length : i;
+	}
+
+	return length;
+}
+
+/**
+ * Get the length of a UTF-16 chunk without an incomplete code unit or
+ * an unpaired high surrogate at its end.
+ *
+ * @param {Buffer} chunk - The bytes.
+ * @param {Boolean} littleEndian - Byte order of the code units.
+ * @return {Number} The length.
+ */
+function utf16CompleteLength(chunk, littleEndian) {
+	var length = chunk.length - chunk.length % 2;
+
+	if(length === 0)
+		return 0;
+
+	// A high surrogate waits for the low surrogate in the next chunk
+	var unit = littleEndian ? chunk.readUint16LE(length - 2) : chunk.readUint16BE(length - 2);
+	return unit >= 0xD800 && unit <= 0xDBFF ? length - 2 : length;
+}
+
+/**
+ * Reads a file in chunks, in the background.
+ *
+ * Events:
+ * - `data` (chunk) A Buffer, or a string with an encoding.
+ * - `end` () All data has been read.
+ * - `error` (error)
+ * - `close` () The file has been closed.
+ *
+ * Only one chunk is read ahead. While paused, nothing is read.
+ *
+ * @constructor
+ * @param {String} path - Path of the file.
+ * @param {Object} [options]
+ * @param {String} [options.encoding] - Encoding of string chunks.
+ * @param {Number} [options.highWaterMark=65536] - Size of the chunks.
+ * @param {Number} [options.start=0] - First byte to read.
+ * @param {Number} [options.end] - Last byte to read, inclusive.
+ * @throws {Error} If the file can not be opened.
+ */
+function ReadStream(path, options) {
+	Stream.call(this);
+	options = options || {};
+
+	this.path = path;
+	this.highWaterMark = options.highWaterMark || 64 * 1024;
+	this.position = options.start >>> 0;
+	this.bytesRead = 0;
+	this.readable = true;
+	this.paused = false;
+
+	this._end = util.isNumber(options.end) ? options.end + 1 : Infinity;
+	this._decoder = options.encoding ? new ChunkDecoder(options.encoding) : null;
+	this._reading = false;
+	this._pendingChunk = null;
+	this._file = new RawFile(path, "r");
+
+	// Callbacks arrive later, after listeners are added
+	this._read();
+}
+util.inherits(ReadStream, Stream);
+
+/**
+ * Read the next chunk, unless paused, reading or done.
+ */
+ReadStream.prototype._read = function () {
+	var self = this;
+	var length = Math.min(this.highWaterMark, this._end - this.position);
+
+	if(this._reading || this.paused || !this.readable)
+		return;
+	if(length <= 0)
+		return this._finish();
+
+	this._reading = true;
+	this._file.readAsync(length, this.position, function (error, chunk) {
+		self._reading = false;
+
+		if(!self.readable)
+			return;
+		if(error) {
+			self.destroy();
+			self.emit("error", error);
+			return;
+		}
+		if(chunk.length === 0)
+			return self._finish();
+
+		self.position += chunk.length;
+		self.bytesRead += chunk.length;
+
+		if(self.paused)
+			self._pendingChunk = chunk;
+		else {
+			self._emitChunk(chunk);
+			self._read();
+		}
+	});
+};
+
+/**
+ * Send a chunk to the listeners.
+ *
+ * @param {Buffer} chunk - The chunk.
+ */
+ReadStream.prototype._emitChunk = function (chunk) {
+	this.emit("data", this._decoder ? this._decoder.write(chunk) : chunk);
+};
+
+/**
+ * End the stream after the last chunk.
+ */
+ReadStream.prototype._finish = function () {
+	if(!this.readable)
+		return;
+
+	if(this._decoder) {
+		var rest = this._decoder.end();
+		if(rest.length > 0)
+			this.emit("data", rest);
+	}
+
+	this.destroy();
+	this.emit("end");
+};
+
+/**
+ * Stop reading.
+ *
+ * @return {ReadStream} The stream.
+ */
+ReadStream.prototype.pause = function () {
+	this.paused = true;
+	return this;
+};
+
+/**
+ * Continue reading.
+ *
+ * @return {ReadStream} The stream.
+ */
+ReadStream.prototype.resume = function () {
+	var chunk = this._pendingChunk;
+
+	if(!this.paused)
+		return this;
+
+	this.paused = false;
+	this._pendingChunk = null;
+	if(chunk)
+		this._emitChunk(chunk);
+
+	this._read();
+	return this;
+};
+
+/**
+ * Stop reading and close the file.
+ */
+ReadStream.prototype.destroy = function () {
+	var self = this;
+
+	if(!this.readable)
+		return;
+	this.readable = false;
+
+	this._file.close(function () {
+		self.emit("close");
+	});
+};
+
+/**
+ * Write all data to a writable stream, pausing while it is full.
+ *
+ * @param {WriteStream} destination - The stream to write to.
+ * @param {Object} [options]
+ * @param {Boolean} [options.end=true] - End the destination at the end.
+ * @return {WriteStream} The destination.
+ */
+ReadStream.prototype.pipe = function (destination, options) {
+	var self = this;
+
+	this.on("data", function (chunk) {
+		if(destination.write(chunk) === false) {
+			self.pause();
+			destination.once("drain", function () {
+				self.resume();
+			});
+		}
+	});
+
+	if(!options || options.end !== false) {
+		this.on("end", function () {
+			destination.end();
+		});
+	}
+
+	return destination;
+};
+
+exports.ReadStream = ReadStream;
+
+/**
+ * Writes to a file in the background.
+ *
+ * write() returns false once highWaterMark bytes are waiting to be
+ * written. Wait for `drain` before writing more.
+ *
+ * Events:
+ * - `drain` () The waiting bytes dropped below highWaterMark.
+ * - `finish` () All data has been written after end().
+ * - `error` (error)
+ * - `close` () The file has been closed.
+ *
+ * @constructor
+ * @param {String} path - Path of the file.
+ * @param {Object} [options]
+ * @param {String} [options.flags=w] - Flags to open with.
+ * @param {String} [options.encoding=utf8] - Encoding of string chunks.
+ * @param {Number} [options.highWaterMark=16384] - Bytes to accept
+ * before write() returns false.
+ * @param {Number} [options.start] - Position to start writing at.
+ * @throws {Error} If the file can not be opened.
+ */
+function WriteStream(path, options) {
+	Stream.call(this);
+	options = options || {};
+
+	this.path = path;
+	this.highWaterMark = options.highWaterMark || 16 * 1024;
+	this.encoding = options.encoding || "utf8";
+	this.bytesWritten = 0;
+	this.writable = true;
+
+	this._position = util.isNumber(options.start) ? options.start : -1;
+	this._pending = 0;
+	this._needDrain = false;
+	this._ending = false;
+	this._closing = false;
+	this._file = new RawFile(path, options.flags || "w");
+}
+util.inherits(WriteStream, Stream);
+
+/**
+ * Write a chunk.
+ *
+ * @param {Buffer|String} chunk - The data.
+ * @param {String} [encoding] - Encoding of a string.
+ * @param {Function} [callback] - Called with (error) when written.
+ * @return {Boolean} false if the caller should wait for `drain`.
+ */
+WriteStream.prototype.write = function (chunk, encoding, callback) {
+	var self = this;
+	var position = this._position;
+
+	if(util.isFunction(encoding)) {
+		callback = encoding;
+		encoding = undefined;
+	}
+	if(!this.writable)
+		throw new Error("Write after end.");
+
+	if(!util.isBuffer(chunk))
+		chunk = new Buffer(String(chunk), encoding || this.encoding);
+
+	if(position >= 0)
+		this._position += chunk.length;
+	this._pending += chunk.length;
+
+	this._file.writeAsync(chunk, position, function (error, written) {
+		self._pending -= chunk.length;
+		if(!error)
+			self.bytesWritten += written;
+
+		if(callback)
+			callback(error);
+		if(error)
+			self.emit("error", error);
+
+		if(self._needDrain && self._pending < self.highWaterMark) {
+			self._needDrain = false;
+			self.emit("drain");
+		}
+		if(self._ending && self._pending === 0)
+			self._close();
+	});
+
+	if(this._pending >= this.highWaterMark) {
+		this._needDrain = true;
+		return false;
+	}
+
+	return true;
+};
+
+/**
+ * Write a last chunk, and close the file when everything is written.
+ *
+ * @param {Buffer|String} [chunk] - The data.
+ * @param {String} [encoding] - Encoding of a string.
+ * @param {Function} [callback] - Called on `finish`.
+ */
+WriteStream.prototype.end = function (chunk, encoding, callback) {
+	if(util.isFunction(chunk)) {
+		callback = chunk;
+		chunk = null;
+	} else if(util.isFunction(encoding)) {
+		callback = encoding;
+		encoding = undefined;
+	}
+
+	if(chunk !== null && !util.isUndefined(chunk))
+		this.write(chunk, encoding);
+
+	if(callback)
+		this.once("finish", callback);
+
+	this.writable = false;
+	this._ending = true;
+	if(this._pending === 0)
+		this._close();
+};
+
+/**
+ * Close the file after the last write.
+ */
+WriteStream.prototype._close = function () {
+	var self = this;
+
+	if(this._closing)
+		return;
+	this._closing = true;
+
+	this._file.close(function (error) {
+		if(error)
+			return self.emit("error", error);
+
+		self.emit("finish");
+		self.emit("close");
+	});
+};
+
+exports.WriteStream = WriteStream;
+
+/// Create a ReadStream. See ReadStream.
+exports.createReadStream = function (path, options) {
+	return new ReadStream(path, options);
+};
+
+/// Create a WriteStream. See WriteStream.
+exports.createWriteStream = function (path, options) {
+	return new WriteStream(path, options);
+};
@@ -35,8 +35,16 @@ var _myEmitter = new EventEmitter();
 exports.name = "Andromeda Test";
 exports.author = "Jos 'Rahkiin' Kuijpers";
 
-exports.on = function (name,fn) {
-	return _myEmitter.on(name,fn);
+exports.on = function (name,fn,priority) {
+	return _myEmitter.on(name,fn,priority);
+};
+
+exports.once = function (name,fn,priority) {
+	return _myEmitter.once(name,fn,priority);
+};
+
+exports.off = function (target,fn) {
+	return _myEmitter.off(target,fn);
 };
 
 exports.trigger = function (name,args) {
@@ -92,8 +92,16 @@ function Sound(path) {
 		nativeSound.position = 0.0;
 	};
 	
-	this.on = function(event,fn) {
-		nativeSound.on(event,fn);
+	this.on = function(event,fn,priority) {
+		return nativeSound.on(event,fn,priority);
+	};
+
+	this.once = function(event,fn,priority) {
+		return nativeSound.once(event,fn,priority);
+	};
+
+	this.off = function(target,fn) {
+		nativeSound.off(target,fn);
 	};
 }
 exports.Sound = Sound;
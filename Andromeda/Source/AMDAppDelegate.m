@@ -31,6 +31,7 @@
 #import "AMDJSClass.h"
 #import "AMDConsole.h"
 #import "AMDEngine.h"
+#import "AMDFileWatcher.h"
 
 void load_bundle_script(L8Context *context, NSString *name);
 
@@ -38,6 +39,7 @@ void load_bundle_script(L8Context *context, NSString *name);
 	L8Context *_javaScriptContext;
 	AMDGraphicsEngine *_graphicsEngine;
 	AMDEngine *_engine;
+	AMDFileWatcher *_fileWatcher;
 }
 
 - (void)applicationDidFinishLaunching:(NSNotification *)aNotification
@@ -48,6 +50,13 @@ void load_bundle_script(L8Context *context, NSString *name);
 
 	_javaScriptContext = [[L8Context alloc] init];
 
+#ifdef DEBUG
+	// Reload scripts and assets when they are edited
+	_fileWatcher = [[AMDFileWatcher alloc] initWithPaths:@[[[NSBundle mainBundle] resourcePath]]
+												 latency:0.1];
+	[_fileWatcher start];
+#endif
+
 	[_javaScriptContext executeBlockInContext:^(L8Context *context) {
 		L8Value *ret;
 		NSString *mainPath;
@@ -59,6 +68,8 @@ void load_bundle_script(L8Context *context, NSString *name);
 		context[@"engine"] = _engine;
 		context[@"global"] = context.globalObject;
 
+		[_engine warmUpPreviouslyUsedBindings];
+
 		mainPath = [[NSBundle mainBundle] pathForResource:@"andromeda"
 														 ofType:@"js"];
 
@@ -24,20 +24,27 @@
  */
 
 #import <L8Framework/L8Export.h>
+#import "AMDRegistry.h"
 
 @class L8Value;
 
 /**
- * @brief A ObjC/JS binding protocol.
+ * Register a binding under a name, for engine.binding().
+ *
+ * Use once, in the implementation file of the class.
+ *
+ * @param cls The class.
+ * @param name Name of the binding, a C string.
  */
-@protocol AMDBinding <NSObject>
+#define AMD_REGISTER_BINDING(cls, name) \
+	AMD_REGISTRY_ADD(AMD_REGISTRY_SECTION_BINDINGS, cls, name)
 
 /**
- * Get the name of the binding.
+ * @brief A ObjC/JS binding protocol.
  *
- * @return Name of the binding.
+ * The binding is set up the first time it is asked for.
  */
-+ (NSString *)bindingName;
+@protocol AMDBinding <NSObject>
 
 /**
  * Set up the exports for the binding.
@@ -28,21 +28,67 @@
 
 @class L8Value;
 
+/// How triggers of an event that are still pending are combined.
+typedef enum {
+	/// Every trigger is delivered.
+	AMDEventCoalescingNone,
+	/// Only the last pending trigger is delivered.
+	AMDEventCoalescingLatest,
+	/// Numeric arguments of pending triggers are added up.
+	AMDEventCoalescingSum
+} AMDEventCoalescing;
+
 /**
  * @brief JavaScript exports for classes that send events.
  *
  * Provides the on() function for JavaScript to register callbacks.
+ *
+ * Events can be namespaced, like 'menu:open'. A listener for an event
+ * ending in '*' receives all events starting with what comes before
+ * it: 'menu:*' receives 'menu:open' and 'menu:close', '*' receives
+ * every event.
  */
 @protocol AMDEventEmitter <L8Export>
 
 /**
  * Add an event listener for an event.
  *
- * @param event The event. [keydown,keyup]
+ * Listeners with a higher priority are called first. Listeners with
+ * the same priority are called in the order they were added.
+ *
+ * @param event The event or wildcard. [keydown,keyup]
  * @param function The JS function.
+ * @!param priority The priority. [optional, default 0]
+ * @return A handle for off().
  */
 L8_EXPORT_AS(on,
-- (void)addEventListener:(NSString *)event function:(L8Value *)function
+- (uint32_t)addEventListener:(NSString *)event function:(L8Value *)function
+);
+
+/**
+ * Add an event listener that is removed after it was called once.
+ *
+ * @param event The event or wildcard.
+ * @param function The JS function.
+ * @!param priority The priority. [optional, default 0]
+ * @return A handle for off().
+ */
+L8_EXPORT_AS(once,
+- (uint32_t)addOnceEventListener:(NSString *)event function:(L8Value *)function
+);
+
+/**
+ * Remove event listeners.
+ *
+ * With a handle, removes that listener. With an event and a function,
+ * removes that function from the event. With only an event, removes
+ * all its listeners.
+ *
+ * @param target A handle returned by on() or once(), or an event.
+ * @param function The JS function. [optional]
+ */
+L8_EXPORT_AS(off,
+- (void)removeEventListeners:(L8Value *)target function:(L8Value *)function
 );
 
 /**
@@ -59,11 +105,56 @@ L8_EXPORT_AS(trigger,
 
 /**
  * @brief A class that sends and receives events.
+ *
+ * Triggered events are not delivered right away, but put on a queue
+ * that is shared by all emitters. The queue is emptied on the main
+ * queue in one go, entering the JavaScript context once for all
+ * pending events. Listeners receive the event as registered at the
+ * time of the trigger, so they can safely remove themselves.
  */
 @interface AMDEventEmitter : NSObject <AMDEventEmitter,AMDBinding>
 
+/**
+ * Add an event listener.
+ *
+ * @param event The event or wildcard.
+ * @param function The JS function.
+ * @param priority The priority. Higher is called earlier.
+ * @param once YES to remove the listener after its first call.
+ * @return A handle of the listener.
+ */
+- (uint32_t)addEventListener:(NSString *)event
+					function:(L8Value *)function
+					priority:(int)priority
+						once:(BOOL)once;
+
+/**
+ * Remove an event listener by its handle.
+ *
+ * @param handle The handle of the listener.
+ */
+- (void)removeEventListenerWithHandle:(uint32_t)handle;
+
 - (void)removeEventListener:(NSString *)event function:(L8Value *)function;
 
 - (void)removeAllEventListeners:(NSString *)event;
 
+/**
+ * Set how pending triggers of an event are combined.
+ *
+ * Useful for high-frequency events, such as mouse scrolling.
+ *
+ * @param coalescing The coalescing policy.
+ * @param event The event.
+ */
+- (void)setCoalescing:(AMDEventCoalescing)coalescing forEvent:(NSString *)event;
+
+/**
+ * Deliver all pending events now.
+ *
+ * Must be called on the main thread. Events triggered by listeners
+ * are delivered in the next flush.
+ */
++ (void)flushEventQueue;
+
 @end
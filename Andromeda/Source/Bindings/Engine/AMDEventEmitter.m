@@ -26,9 +26,84 @@
 #import "AMDEventEmitter.h"
 
 #import <L8Framework/L8.h>
+#import "L8Value+AMDLazyProperties.h"
+
+/**
+ * @brief A registered event listener.
+ */
+@interface AMDEventListener : NSObject
+@property (strong) L8Value *function;
+@property (copy) NSString *event;
+@property (assign) uint32_t handle;
+@property (assign) int priority;
+@property (assign) BOOL once;
+@property (assign) BOOL removed;
+@property (weak) AMDEventEmitter *emitter;
+@end
+
+@implementation AMDEventListener
+@end
+
+/**
+ * @brief The listeners of an event, highest priority first.
+ *
+ * The array is never changed, only replaced, so holding on to it is a
+ * snapshot. Removed listeners are marked and only taken out when they
+ * make up half of the list.
+ */
+@interface AMDEventListenerList : NSObject
+@property (strong) NSArray *listeners;
+@property (assign) NSUInteger numberOfRemoved;
+@end
+
+@implementation AMDEventListenerList
+@end
+
+/**
+ * @brief A triggered event, waiting to be delivered.
+ */
+@interface AMDPendingEvent : NSObject
+@property (strong) NSArray *listeners;
+@property (strong) NSArray *arguments;
+@property (readonly) L8Context *context;
+@end
+
+@implementation AMDPendingEvent
+
+- (L8Context *)context
+{
+	return [[(AMDEventListener *)_listeners[0] function] context];
+}
+
+@end
+
+/// Events waiting to be delivered, in order of triggering.
+static NSMutableArray *amd_event_queue;
+
+/// Pending coalesced events, by emitter and event name.
+static NSMutableDictionary *amd_event_queue_coalesced;
+
+/// Whether a flush is on the main queue.
+static BOOL amd_event_queue_scheduled;
+
+/// Last handed out listener handle.
+static uint32_t amd_event_last_handle;
+
+AMD_REGISTER_BINDING(AMDEventEmitter, "event");
 
 @implementation AMDEventEmitter {
-	NSMutableDictionary *_eventCallbacks;
+	NSMutableDictionary *_eventCallbacks; // Event -> AMDEventListenerList
+	NSMutableDictionary *_wildcardCallbacks; // Prefix -> AMDEventListenerList
+	NSMutableDictionary *_listenersByHandle;
+	NSMutableDictionary *_coalescing;
+}
+
++ (void)initialize
+{
+	if(self == [AMDEventEmitter class]) {
+		amd_event_queue = [[NSMutableArray alloc] init];
+		amd_event_queue_coalesced = [[NSMutableDictionary alloc] init];
+	}
 }
 
 + (L8Value *)setUpBinding
@@ -36,86 +111,352 @@
 	L8Value *wrapper;
 
 	wrapper = [L8Value valueWithNewObjectInContext:[L8Context currentContext]];
-	wrapper[@"EventEmitter"] = [AMDEventEmitter class];
+	[wrapper defineLazyProperty:@"EventEmitter" withBlock:^id{
+		return [AMDEventEmitter class];
+	}];
 
 	return wrapper;
 }
 
-+ (NSString *)bindingName
-{
-	return @"event";
-}
-
 - (id)init
 {
     self = [super init];
     if AMD_LIKELY(self) {
 		_eventCallbacks = [[NSMutableDictionary alloc] init];
+		_wildcardCallbacks = [[NSMutableDictionary alloc] init];
+		_listenersByHandle = [[NSMutableDictionary alloc] init];
+		_coalescing = [[NSMutableDictionary alloc] init];
 	}
 
     return self;
 }
 
+#pragma mark - Triggering
+
+/**
+ * Get the listeners for an event, including those of matching
+ * wildcards. Must be called while synchronized on self.
+ *
+ * @param event The event.
+ * @return An array of AMDEventListeners, highest priority first.
+ */
+- (NSArray *)listenersForEvent:(NSString *)event
+{
+	NSArray *listeners;
+	NSMutableArray *merged = nil;
+
+	listeners = [_eventCallbacks[event] listeners];
+	if AMD_LIKELY(_wildcardCallbacks.count == 0)
+		return listeners;
+
+	[_wildcardCallbacks enumerateKeysAndObjectsUsingBlock:^(NSString *prefix,
+															AMDEventListenerList *list,
+															BOOL *stop) {
+		// -hasPrefix: is NO for the empty string, which a bare '*' is stored as
+		if(prefix.length > 0 && ![event hasPrefix:prefix])
+			return;
+		if(merged == nil)
+			merged = [NSMutableArray arrayWithArray:listeners];
+		[merged addObjectsFromArray:list.listeners];
+	}];
+
+	if(merged == nil)
+		return listeners;
+
+	// Stable, so equal priorities keep their order
+	return [merged sortedArrayWithOptions:NSSortStable
+						  usingComparator:^NSComparisonResult(AMDEventListener *a,
+															  AMDEventListener *b) {
+		if(a.priority == b.priority)
+			return NSOrderedSame;
+		return (a.priority > b.priority) ? NSOrderedAscending : NSOrderedDescending;
+	}];
+}
+
 - (void)triggerEvent:(NSString *)event withArguments:(NSArray *)arguments
 {
+	AMDEventCoalescing coalescing;
+	AMDPendingEvent *pending;
 	NSArray *listeners;
+	id key = nil;
 
-	listeners = _eventCallbacks[event];
-	if AMD_UNLIKELY(listeners == nil)
+	@synchronized(self) {
+		listeners = [self listenersForEvent:event];
+		coalescing = [_coalescing[event] intValue];
+	}
+
+	if AMD_UNLIKELY(listeners.count == 0)
 		return;
 
-	for(L8Value *function in listeners) {
-		if(![function isFunction])
-			continue;
+	if(arguments == nil)
+		arguments = @[];
+
+	@synchronized(amd_event_queue) {
+		if(coalescing != AMDEventCoalescingNone) {
+			key = @[[NSValue valueWithNonretainedObject:self], event];
+			pending = amd_event_queue_coalesced[key];
+
+			if(pending != nil) {
+				pending.listeners = listeners;
+				if(coalescing == AMDEventCoalescingSum)
+					pending.arguments = [self sumOfArguments:pending.arguments
+											   withArguments:arguments];
+				else
+					pending.arguments = arguments;
+				return;
+			}
+		}
+
+		pending = [[AMDPendingEvent alloc] init];
+		pending.listeners = listeners;
+		pending.arguments = arguments;
+
+		[amd_event_queue addObject:pending];
+		if(key != nil)
+			amd_event_queue_coalesced[key] = pending;
+
+		// One hop to the main queue for the whole batch
+		if(!amd_event_queue_scheduled) {
+			amd_event_queue_scheduled = YES;
+			dispatch_async(dispatch_get_main_queue(), ^{
+				[AMDEventEmitter flushEventQueue];
+			});
+		}
+	}
+}
+
+- (NSArray *)sumOfArguments:(NSArray *)left withArguments:(NSArray *)right
+{
+	NSMutableArray *result;
+
+	result = [NSMutableArray arrayWithCapacity:right.count];
+	for(NSUInteger i = 0; i < right.count; ++i) {
+		if(i < left.count
+		   && [left[i] isKindOfClass:[NSNumber class]]
+		   && [right[i] isKindOfClass:[NSNumber class]])
+			[result addObject:@([left[i] doubleValue] + [right[i] doubleValue])];
+		else
+			[result addObject:right[i]];
+	}
+
+	return result;
+}
+
++ (void)flushEventQueue
+{
+	NSArray *events;
+	NSUInteger count, start = 0;
+
+	@synchronized(amd_event_queue) {
+		events = [amd_event_queue copy];
+		[amd_event_queue removeAllObjects];
+		[amd_event_queue_coalesced removeAllObjects];
+		amd_event_queue_scheduled = NO;
+	}
+
+	// Enter each context once, for a run of events
+	count = events.count;
+	while(start < count) {
+		L8Context *context = [events[start] context];
+		NSUInteger end = start + 1;
+
+		while(end < count && [events[end] context] == context)
+			end++;
+
+		[context executeBlockInContext:^(L8Context *ctx) {
+			for(NSUInteger i = start; i < end; ++i) {
+				AMDPendingEvent *pending = events[i];
+
+				for(AMDEventListener *listener in pending.listeners) {
+					// Removed after the trigger, or a once-listener that already ran
+					if(listener.removed)
+						continue;
 
-		dispatch_async(dispatch_get_main_queue(), ^{
-			[function.context executeBlockInContext:^(L8Context *context) {
-				@try {
-					[function callWithArguments:arguments];
-				} @catch(id exc) {
-					fprintf(stderr,"[EXC ] %s\n",[[exc description] UTF8String]);
+					if(listener.once)
+						[listener.emitter removeEventListenerWithHandle:listener.handle];
+
+					@try {
+						[listener.function callWithArguments:pending.arguments];
+					} @catch(id exc) {
+						fprintf(stderr,"[EXC ] %s\n",[[exc description] UTF8String]);
+					}
 				}
-			}];
-		});
+			}
+		}];
+
+		start = end;
 	}
 }
 
-- (void)addEventListener:(NSString *)event function:(L8Value *)function
+- (void)setCoalescing:(AMDEventCoalescing)coalescing forEvent:(NSString *)event
+{
+	@synchronized(self) {
+		if(coalescing == AMDEventCoalescingNone)
+			[_coalescing removeObjectForKey:event];
+		else
+			_coalescing[event] = @(coalescing);
+	}
+}
+
+#pragma mark - Listeners
+
+- (uint32_t)addEventListener:(NSString *)event function:(L8Value *)function
 {
+	NSArray *args = [L8Context currentArguments];
+	int priority = (args.count >= 3) ? [args[2] toInt32] : 0;
+
+	return [self addEventListener:event function:function priority:priority once:NO];
+}
+
+- (uint32_t)addOnceEventListener:(NSString *)event function:(L8Value *)function
+{
+	NSArray *args = [L8Context currentArguments];
+	int priority = (args.count >= 3) ? [args[2] toInt32] : 0;
+
+	return [self addEventListener:event function:function priority:priority once:YES];
+}
+
+- (uint32_t)addEventListener:(NSString *)event
+					function:(L8Value *)function
+					priority:(int)priority
+						once:(BOOL)once
+{
+	AMDEventListener *listener;
+	AMDEventListenerList *list;
+	NSMutableDictionary *lists;
 	NSMutableArray *listeners;
+	NSString *key;
+	NSUInteger index;
 
-	if AMD_UNLIKELY(![function isFunction])
+	if AMD_UNLIKELY(event == nil || ![function isFunction])
+		return 0;
+
+	listener = [[AMDEventListener alloc] init];
+	listener.function = function;
+	listener.event = event;
+	listener.priority = priority;
+	listener.once = once;
+	listener.emitter = self;
+
+	// A trailing '*' makes a wildcard for everything with that prefix
+	if([event hasSuffix:@"*"]) {
+		lists = _wildcardCallbacks;
+		key = [event substringToIndex:event.length - 1];
+	} else {
+		lists = _eventCallbacks;
+		key = event;
+	}
+
+	@synchronized(self) {
+		if(++amd_event_last_handle == 0)
+			amd_event_last_handle = 1;
+		listener.handle = amd_event_last_handle;
+
+		list = lists[key];
+		if(list == nil) {
+			list = [[AMDEventListenerList alloc] init];
+			lists[key] = list;
+		}
+
+		// After all listeners with the same or a higher priority
+		listeners = [NSMutableArray arrayWithArray:list.listeners];
+		for(index = listeners.count; index > 0; --index) {
+			if([listeners[index - 1] priority] >= priority)
+				break;
+		}
+		[listeners insertObject:listener atIndex:index];
+		list.listeners = [listeners copy];
+
+		_listenersByHandle[@(listener.handle)] = listener;
+	}
+
+	return listener.handle;
+}
+
+/**
+ * Remove a listener. Must be called while synchronized on self.
+ *
+ * @param listener The listener.
+ */
+- (void)removeListener:(AMDEventListener *)listener
+{
+	AMDEventListenerList *list;
+	NSMutableDictionary *lists;
+	NSString *key;
+
+	if(listener.removed)
 		return;
+	listener.removed = YES;
+	[_listenersByHandle removeObjectForKey:@(listener.handle)];
 
-	listeners = _eventCallbacks[event];
-	if(listeners == nil) {
-		listeners = [NSMutableArray arrayWithCapacity:1];
-		_eventCallbacks[event] = listeners;
+	if([listener.event hasSuffix:@"*"]) {
+		lists = _wildcardCallbacks;
+		key = [listener.event substringToIndex:listener.event.length - 1];
+	} else {
+		lists = _eventCallbacks;
+		key = listener.event;
 	}
 
-	[listeners addObject:function];
+	list = lists[key];
+	list.numberOfRemoved++;
+
+	// Take removed listeners out once they are half of the list
+	if(list.numberOfRemoved * 2 >= list.listeners.count) {
+		NSPredicate *predicate;
+
+		predicate = [NSPredicate predicateWithFormat:@"removed == NO"];
+		list.listeners = [list.listeners filteredArrayUsingPredicate:predicate];
+		list.numberOfRemoved = 0;
+
+		if(list.listeners.count == 0)
+			[lists removeObjectForKey:key];
+	}
 }
 
-- (void)removeEventListener:(NSString *)event function:(L8Value *)function
+- (void)removeEventListenerWithHandle:(uint32_t)handle
 {
-	NSMutableArray *listeners;
+	@synchronized(self) {
+		AMDEventListener *listener = _listenersByHandle[@(handle)];
+
+		if(listener != nil)
+			[self removeListener:listener];
+	}
+}
+
+- (void)removeEventListeners:(L8Value *)target function:(L8Value *)function
+{
+	if([target isNumber])
+		[self removeEventListenerWithHandle:[target toUInt32]];
+	else if([target isString]) {
+		if([function isFunction])
+			[self removeEventListener:[target toString] function:function];
+		else
+			[self removeAllEventListeners:[target toString]];
+	}
+}
 
+- (void)removeEventListener:(NSString *)event function:(L8Value *)function
+{
 	if AMD_UNLIKELY(![function isFunction])
 		return;
 
-	listeners = _eventCallbacks[event];
-	[listeners removeObject:function];
+	@synchronized(self) {
+		for(AMDEventListener *listener in [_listenersByHandle allValues]) {
+			if([listener.event isEqualToString:event]
+			   && [listener.function isEqual:function])
+				[self removeListener:listener];
+		}
+	}
 }
 
 - (void)removeAllEventListeners:(NSString *)event
 {
-	NSMutableArray *listeners;
-
-	if(event != nil) {
-		listeners = _eventCallbacks[event];
-		[listeners removeAllObjects];
-	} else
-		[_eventCallbacks removeAllObjects];
+	@synchronized(self) {
+		for(AMDEventListener *listener in [_listenersByHandle allValues]) {
+			if(event == nil || [listener.event isEqualToString:event])
+				[self removeListener:listener];
+		}
+	}
 }
 
 @end
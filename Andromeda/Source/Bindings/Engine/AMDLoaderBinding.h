@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDBinding.h"
+
+@class AMDLoadRequest;
+
+/**
+ * @brief A load in progress: JavaScript exports.
+ */
+@protocol AMDLoadRequest <L8Export>
+
+/// Absolute path of the file.
+@property (readonly) NSString *path;
+
+/// Priority of the load, -4 (low) to 4 (high). Can be changed until
+/// the load starts.
+@property (assign) int priority;
+
+/**
+ * Cancel the load. The callback will not be called.
+ */
+- (void)cancel;
+
+@end
+
+/**
+ * @brief A load in progress.
+ */
+@interface AMDLoadRequest : NSObject <AMDLoadRequest>
+
+@end
+
+/**
+ * @brief Binding for loading on background threads: JavaScript exports.
+ *
+ * Callbacks are called on the main queue with (error, result).
+ */
+@protocol AMDLoaderBinding <L8Export>
+
+/**
+ * Load a resource, like a map or a sprite set.
+ *
+ * The loaded resource is kept in the resource cache, and used when
+ * the game asks for the resource at the returned path. It is certain
+ * to be cached only while the callback runs: a resource that is not
+ * used by then may be evicted, and loaded again when it is used.
+ *
+ * @param path Path of the resource.
+ * @param priority Priority of the load.
+ * @param callback Called with the absolute path of the resource.
+ * @return The request.
+ */
+L8_EXPORT_AS(load,
++ (AMDLoadRequest *)loadResourceAtPath:(NSString *)path priority:(int)priority callback:(L8Value *)callback
+);
+
+/**
+ * Read a UTF-8 text file.
+ *
+ * @param path Absolute path of the file.
+ * @param priority Priority of the load.
+ * @param callback Called with the contents of the file.
+ * @return The request.
+ */
+L8_EXPORT_AS(readFile,
++ (AMDLoadRequest *)readFileAtPath:(NSString *)path priority:(int)priority callback:(L8Value *)callback
+);
+
+/**
+ * Get the statistics of the resource cache.
+ *
+ * @return An object with hits, misses, evictions, resources,
+ * memoryUsage and memoryBudget.
+ */
+L8_EXPORT_AS(cacheStatistics,
++ (NSDictionary *)cacheStatistics
+);
+
+/**
+ * Set the memory budget of the resource cache.
+ *
+ * @param bytes The budget in bytes.
+ */
+L8_EXPORT_AS(setCacheMemoryBudget,
++ (void)setCacheMemoryBudget:(double)bytes
+);
+
+@end
+
+/**
+ * @brief Binding for loading on background threads.
+ */
+@interface AMDLoaderBinding : NSObject <AMDLoaderBinding, AMDBinding>
+
+@end
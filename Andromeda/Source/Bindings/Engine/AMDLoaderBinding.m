@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDLoaderBinding.h"
+
+#import <L8Framework/L8.h>
+#import <AndromedaKit/AndromedaKit.h>
+
+AMD_REGISTER_BINDING(AMDLoaderBinding, "loader");
+
+/**
+ * Call a load callback in its context.
+ *
+ * @param callback The callback.
+ * @param error The error message, or nil on success.
+ * @param result The result, or nil on failure.
+ */
+static void amd_loader_call_callback(L8Value *callback, NSString *error, id result);
+
+/**
+ * Clamp a priority from a script to the priorities of the loader.
+ *
+ * @param priority The priority, -4 (low) to 4 (high).
+ * @return The load priority.
+ */
+static AMKResourceLoadPriority amd_loader_priority(int priority);
+
+@interface AMDLoadRequest ()
+- (instancetype)initWithRequest:(AMKResourceRequest *)request path:(NSString *)path;
+@end
+
+@implementation AMDLoadRequest {
+	AMKResourceRequest *_request;
+}
+
+@synthesize path=_path;
+
+- (instancetype)initWithRequest:(AMKResourceRequest *)request path:(NSString *)path
+{
+	self = [super init];
+	if(self) {
+		_request = request;
+		_path = [path copy];
+	}
+	return self;
+}
+
+- (int)priority
+{
+	return _request.priority;
+}
+
+- (void)setPriority:(int)priority
+{
+	_request.priority = amd_loader_priority(priority);
+}
+
+- (void)cancel
+{
+	[_request cancel];
+}
+
+@end
+
+@implementation AMDLoaderBinding
+
++ (L8Value *)setUpBinding
+{
+	return [L8Value valueWithObject:[AMDLoaderBinding class]
+						  inContext:[L8Context currentContext]];
+}
+
++ (NSDictionary *)cacheStatistics
+{
+	amk_resource_cache_statistics_t statistics;
+
+	statistics = [AMKResourceCache sharedCache].statistics;
+
+	return @{@"hits" : @(statistics.hits),
+			 @"misses" : @(statistics.misses),
+			 @"evictions" : @(statistics.evictions),
+			 @"resources" : @(statistics.numberOfResources),
+			 @"memoryUsage" : @(statistics.memoryUsage),
+			 @"memoryBudget" : @([AMKResourceCache sharedCache].memoryBudget)};
+}
+
++ (void)setCacheMemoryBudget:(double)bytes
+{
+	[AMKResourceCache sharedCache].memoryBudget = (NSUInteger)MAX(bytes, 0);
+}
+
+/**
+ * Get the absolute path of a file of the game.
+ *
+ * @param path Absolute path, or the name of a resource.
+ * @return The absolute path, or nil if there is no such resource.
+ */
++ (NSString *)absolutePathForPath:(NSString *)path
+{
+	path = [path stringByExpandingTildeInPath];
+	if(![path hasPrefix:@"/"]) {
+		NSString *ext = [path pathExtension];
+		path = [[path lastPathComponent] stringByDeletingPathExtension];
+		path = [[NSBundle mainBundle] pathForResource:path ofType:ext];
+	}
+
+	return path;
+}
+
++ (AMDLoadRequest *)loadResourceAtPath:(NSString *)path priority:(int)priority callback:(L8Value *)callback
+{
+	AMKResourceRequest *request;
+	AMDLoadRequest *loadRequest;
+	NSString *absolutePath;
+
+	absolutePath = [self absolutePathForPath:path];
+	if(absolutePath == nil) {
+		// Callbacks are never called before the load returns
+		dispatch_async(dispatch_get_main_queue(), ^{
+			amd_loader_call_callback(callback,
+									 [NSString stringWithFormat:@"No such resource '%@'",path],
+									 nil);
+		});
+		return nil;
+	}
+
+	// Scheduled with the priority from the start: the load may begin
+	// before the request is returned
+	request = [[AMKResourceLoader sharedLoader] loadResourceAtPath:absolutePath
+														  priority:amd_loader_priority(priority)
+														completion:^(id resource) {
+		if(resource == nil) {
+			amd_loader_call_callback(callback,
+									 [NSString stringWithFormat:@"Failed to load '%@'",absolutePath],
+									 nil);
+			return;
+		}
+
+		amd_loader_call_callback(callback, nil, absolutePath);
+	}];
+
+	loadRequest = [[AMDLoadRequest alloc] initWithRequest:request path:absolutePath];
+
+	return loadRequest;
+}
+
++ (AMDLoadRequest *)readFileAtPath:(NSString *)path priority:(int)priority callback:(L8Value *)callback
+{
+	AMKResourceRequest *request;
+	AMDLoadRequest *loadRequest;
+
+	path = [path copy];
+	request = [[AMKResourceLoader sharedLoader] loadWithPriority:amd_loader_priority(priority) block:^id{
+		return [NSString stringWithContentsOfFile:path
+										 encoding:NSUTF8StringEncoding
+											error:NULL];
+	} completion:^(NSString *contents) {
+		if(contents == nil) {
+			amd_loader_call_callback(callback,
+									 [NSString stringWithFormat:@"Failed to read '%@'",path],
+									 nil);
+			return;
+		}
+
+		amd_loader_call_callback(callback, nil, contents);
+	}];
+
+	loadRequest = [[AMDLoadRequest alloc] initWithRequest:request path:path];
+
+	return loadRequest;
+}
+
+@end
+
+static void amd_loader_call_callback(L8Value *callback, NSString *error, id result)
+{
+	[callback.context executeBlockInContext:^(L8Context *context) {
+		@try {
+			if(error)
+				[callback callWithArguments:@[error]];
+			else
+				[callback callWithArguments:@[[NSNull null], result]];
+		} @catch(id exc) {
+			fprintf(stderr,"[EXC ] %s\n",[[exc description] UTF8String]);
+		}
+	}];
+}
+
+static AMKResourceLoadPriority amd_loader_priority(int priority)
+{
+	return (AMKResourceLoadPriority)MAX(MIN(priority, AMKResourceLoadPriorityHigh),
+										AMKResourceLoadPriorityLow);
+}
@@ -27,6 +27,8 @@
 
 #import <L8Framework/L8.h>
 
+AMD_REGISTER_BINDING(AMDVirtualMachine, "vm");
+
 @implementation AMDVirtualMachine
 
 + (L8Value *)setUpBinding
@@ -35,11 +37,6 @@
 						  inContext:[L8Context currentContext]];
 }
 
-+ (NSString *)bindingName
-{
-	return @"vm";
-}
-
 + (L8Value *)runInThisContext:(NSString *)code withOptions:(NSDictionary *)options
 {
 	L8Context *context;
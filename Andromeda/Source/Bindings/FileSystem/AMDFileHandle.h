@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <L8Framework/L8.h>
+
+/**
+ * @brief A file opened for reading or writing: JavaScript exports.
+ *
+ * All operations run on a background I/O queue shared by all files, in
+ * the order they were called. The synchronous functions wait for the
+ * pending operations and return the result. The asynchronous functions
+ * call back on the main queue with (error, result). Closing waits for
+ * pending operations.
+ */
+@protocol AMDFileHandle <L8Export>
+
+/// Path of the file.
+@property (readonly) NSString *path;
+
+/// Size of the file in bytes.
+@property (readonly) double size;
+
+/// Whether the file is still open.
+@property (readonly,getter=isOpen) BOOL open;
+
+/**
+ * Read from the file into an ArrayBuffer.
+ *
+ * @param buffer Buffer to read into.
+ * @param offset Offset in the buffer.
+ * @param length Maximum number of bytes to read.
+ * @param position Position in the file, or negative to read at the
+ * current position and move it.
+ * @return Number of bytes read, 0 at the end of the file.
+ */
+L8_EXPORT_AS(read,
+- (double)readIntoBuffer:(L8ArrayBuffer *)buffer
+				  offset:(double)offset
+				  length:(double)length
+				position:(double)position
+);
+
+/**
+ * Write from an ArrayBuffer to the file.
+ *
+ * @param buffer Buffer to write from.
+ * @param offset Offset in the buffer.
+ * @param length Number of bytes to write.
+ * @param position Position in the file, or negative to write at the
+ * current position and move it.
+ * @return Number of bytes written.
+ */
+L8_EXPORT_AS(write,
+- (double)writeFromBuffer:(L8ArrayBuffer *)buffer
+				   offset:(double)offset
+				   length:(double)length
+				 position:(double)position
+);
+
+/**
+ * Read from the file on the I/O queue.
+ *
+ * @param length Maximum number of bytes to read.
+ * @param position Position in the file, or negative for the current
+ * position.
+ * @param callback Called with a new ArrayBuffer of the bytes read,
+ * empty at the end of the file.
+ */
+L8_EXPORT_AS(readAsync,
+- (void)readLength:(double)length
+		  position:(double)position
+		  callback:(L8Value *)callback
+);
+
+/**
+ * Write to the file on the I/O queue.
+ *
+ * The bytes are copied first, so the buffer can be changed right away.
+ *
+ * @param buffer Buffer to write from.
+ * @param offset Offset in the buffer.
+ * @param length Number of bytes to write.
+ * @param position Position in the file, or negative for the current
+ * position.
+ * @param callback Called with the number of bytes written.
+ */
+L8_EXPORT_AS(writeAsync,
+- (void)writeFromBuffer:(L8ArrayBuffer *)buffer
+				 offset:(double)offset
+				 length:(double)length
+			   position:(double)position
+			   callback:(L8Value *)callback
+);
+
+/**
+ * Write pending changes to the disk.
+ */
+- (void)sync;
+
+/**
+ * Close the file, after its pending operations.
+ *
+ * @param callback Called when the file is closed. [optional]
+ */
+L8_EXPORT_AS(close,
+- (void)closeWithCallback:(L8Value *)callback
+);
+
+@end
+
+/**
+ * @brief A file opened for reading or writing.
+ */
+@interface AMDFileHandle : NSObject <AMDFileHandle>
+
+/**
+ * Open a file.
+ *
+ * @param path Path of the file.
+ * @param flags Like fopen(): r, r+, w, w+, a or a+.
+ * @return self, or nil if the file could not be opened.
+ */
+- (instancetype)initWithPath:(NSString *)path flags:(NSString *)flags;
+
+@end
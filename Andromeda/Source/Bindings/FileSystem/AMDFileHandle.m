@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDFileHandle.h"
+#import "AMDArrayBuffer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/// Queue of all file operations, so they run in the order they were called.
+static dispatch_queue_t amd_file_handle_io_queue;
+
+/**
+ * Call a callback on the main queue, within its context.
+ *
+ * @param callback The callback, or nil.
+ * @param error Error message, or nil on success.
+ * @param result The result. NSData becomes an ArrayBuffer.
+ */
+static void amd_file_handle_call_callback(L8Value *callback, NSString *error, id result);
+
+/**
+ * Write all bytes to a file.
+ *
+ * @param fd The file.
+ * @param bytes The bytes.
+ * @param length Number of bytes.
+ * @param position Position in the file, or negative for the current
+ * position.
+ * @return Number of bytes written, or -1 on failure.
+ */
+static ssize_t amd_file_handle_write(int fd, const uint8_t *bytes, size_t length, double position);
+
+/**
+ * Check a range of a buffer, throwing a RangeError if it is invalid.
+ *
+ * @param buffer The buffer.
+ * @param offset Start of the range.
+ * @param length Length of the range.
+ */
+static void amd_file_handle_check_range(L8ArrayBuffer *buffer, double offset, double length);
+
+@implementation AMDFileHandle {
+	int _fd;
+}
+
+@synthesize path=_path;
+@synthesize open=_open;
+
++ (void)initialize
+{
+	if(self == [AMDFileHandle class])
+		amd_file_handle_io_queue = dispatch_queue_create("AMDFileHandle", DISPATCH_QUEUE_SERIAL);
+}
+
+- (instancetype)initWithPath:(NSString *)path flags:(NSString *)flags
+{
+	self = [super init];
+	if(self) {
+		int oflag;
+
+		if([flags isEqualToString:@"r"])
+			oflag = O_RDONLY;
+		else if([flags isEqualToString:@"r+"])
+			oflag = O_RDWR;
+		else if([flags isEqualToString:@"w"])
+			oflag = O_WRONLY | O_CREAT | O_TRUNC;
+		else if([flags isEqualToString:@"w+"])
+			oflag = O_RDWR | O_CREAT | O_TRUNC;
+		else if([flags isEqualToString:@"a"])
+			oflag = O_WRONLY | O_CREAT | O_APPEND;
+		else if([flags isEqualToString:@"a+"])
+			oflag = O_RDWR | O_CREAT | O_APPEND;
+		else
+			@throw [L8TypeErrorException exceptionWithMessage:@"Invalid open flags."];
+
+		_path = [path copy];
+		_fd = open(path.fileSystemRepresentation, oflag | O_CLOEXEC, 0644);
+		if(_fd < 0) {
+			NSLog(@"Failed to open %@: %s",path,strerror(errno));
+			return nil;
+		}
+		_open = YES;
+	}
+	return self;
+}
+
+- (void)dealloc
+{
+	// Pending operations keep the handle alive, so none are left
+	if(_open)
+		close(_fd);
+}
+
+- (double)size
+{
+	struct stat info;
+
+	if(!_open || fstat(_fd, &info) != 0)
+		return 0;
+
+	return info.st_size;
+}
+
+- (double)readIntoBuffer:(L8ArrayBuffer *)buffer
+				  offset:(double)offset
+				  length:(double)length
+				position:(double)position
+{
+	__block ssize_t result;
+	__block int error;
+	uint8_t *bytes;
+
+	if(!_open)
+		@throw [L8Exception exceptionWithMessage:@"File is closed."];
+	amd_file_handle_check_range(buffer, offset, length);
+
+	// On the I/O queue, to keep the order with the asynchronous operations
+	bytes = (uint8_t *)buffer.buffer + (size_t)offset;
+	dispatch_sync(amd_file_handle_io_queue, ^{
+		do {
+			if(position < 0)
+				result = read(_fd, bytes, (size_t)length);
+			else
+				result = pread(_fd, bytes, (size_t)length, (off_t)position);
+		} while(result < 0 && errno == EINTR);
+		error = errno;
+	});
+
+	if(result < 0)
+		@throw [L8Exception exceptionWithMessage:[NSString stringWithFormat:@"Failed to read %@: %s",_path,strerror(error)]];
+
+	return result;
+}
+
+- (double)writeFromBuffer:(L8ArrayBuffer *)buffer
+				   offset:(double)offset
+				   length:(double)length
+				 position:(double)position
+{
+	__block ssize_t result;
+	__block int error;
+	const uint8_t *bytes;
+
+	if(!_open)
+		@throw [L8Exception exceptionWithMessage:@"File is closed."];
+	amd_file_handle_check_range(buffer, offset, length);
+
+	bytes = (const uint8_t *)buffer.buffer + (size_t)offset;
+	dispatch_sync(amd_file_handle_io_queue, ^{
+		result = amd_file_handle_write(_fd, bytes, (size_t)length, position);
+		error = errno;
+	});
+
+	if(result < 0)
+		@throw [L8Exception exceptionWithMessage:[NSString stringWithFormat:@"Failed to write %@: %s",_path,strerror(error)]];
+
+	return result;
+}
+
+- (void)readLength:(double)length
+		  position:(double)position
+		  callback:(L8Value *)callback
+{
+	if(!_open)
+		@throw [L8Exception exceptionWithMessage:@"File is closed."];
+	if(length < 0)
+		@throw [L8RangeErrorException exceptionWithMessage:@"Length must not be negative."];
+
+	dispatch_async(amd_file_handle_io_queue, ^{
+		NSMutableData *data;
+		ssize_t result;
+
+		data = [NSMutableData dataWithLength:(size_t)length];
+		do {
+			if(position < 0)
+				result = read(_fd, data.mutableBytes, data.length);
+			else
+				result = pread(_fd, data.mutableBytes, data.length, (off_t)position);
+		} while(result < 0 && errno == EINTR);
+
+		if(result < 0) {
+			amd_file_handle_call_callback(callback,
+										  [NSString stringWithFormat:@"Failed to read %@: %s",_path,strerror(errno)],
+										  nil);
+			return;
+		}
+
+		data.length = (size_t)result;
+		amd_file_handle_call_callback(callback, nil, data);
+	});
+}
+
+- (void)writeFromBuffer:(L8ArrayBuffer *)buffer
+				 offset:(double)offset
+				 length:(double)length
+			   position:(double)position
+			   callback:(L8Value *)callback
+{
+	NSData *data;
+
+	if(!_open)
+		@throw [L8Exception exceptionWithMessage:@"File is closed."];
+	amd_file_handle_check_range(buffer, offset, length);
+
+	// The buffer belongs to JavaScript, and can change or be collected
+	data = [NSData dataWithBytes:(uint8_t *)buffer.buffer + (size_t)offset
+						  length:(size_t)length];
+
+	dispatch_async(amd_file_handle_io_queue, ^{
+		ssize_t result;
+
+		result = amd_file_handle_write(_fd, data.bytes, data.length, position);
+		if(result < 0) {
+			amd_file_handle_call_callback(callback,
+										  [NSString stringWithFormat:@"Failed to write %@: %s",_path,strerror(errno)],
+										  nil);
+			return;
+		}
+
+		amd_file_handle_call_callback(callback, nil, @(result));
+	});
+}
+
+- (void)sync
+{
+	if(!_open)
+		return;
+
+	dispatch_sync(amd_file_handle_io_queue, ^{
+		fsync(_fd);
+	});
+}
+
+- (void)closeWithCallback:(L8Value *)callback
+{
+	if(!_open) {
+		amd_file_handle_call_callback(callback, nil, nil);
+		return;
+	}
+	_open = NO;
+
+	dispatch_async(amd_file_handle_io_queue, ^{
+		if(close(_fd) != 0) {
+			amd_file_handle_call_callback(callback,
+										  [NSString stringWithFormat:@"Failed to close %@: %s",_path,strerror(errno)],
+										  nil);
+			return;
+		}
+
+		amd_file_handle_call_callback(callback, nil, nil);
+	});
+}
+
+@end
+
+static void amd_file_handle_call_callback(L8Value *callback, NSString *error, id result)
+{
+	if(callback == nil || ![callback isFunction])
+		return;
+
+	dispatch_async(dispatch_get_main_queue(), ^{
+		[callback.context executeBlockInContext:^(L8Context *context) {
+			@try {
+				if(error)
+					[callback callWithArguments:@[error]];
+				else if([result isKindOfClass:[NSData class]])
+					[callback callWithArguments:@[[NSNull null], [AMDArrayBuffer arrayBufferWithData:result]]];
+				else
+					[callback callWithArguments:@[[NSNull null], result ?: [NSNull null]]];
+			} @catch(id exc) {
+				fprintf(stderr,"[EXC ] %s\n",[[exc description] UTF8String]);
+			}
+		}];
+	});
+}
+
+static void amd_file_handle_check_range(L8ArrayBuffer *buffer, double offset, double length)
+{
+	if(offset < 0 || length < 0 || offset + length > buffer.length)
+		@throw [L8RangeErrorException exceptionWithMessage:@"Range must be within buffer."];
+}
+
+static ssize_t amd_file_handle_write(int fd, const uint8_t *bytes, size_t length, double position)
+{
+	size_t written = 0;
+
+	while(written < length) {
+		ssize_t result;
+
+		if(position < 0)
+			result = write(fd, bytes + written, length - written);
+		else
+			result = pwrite(fd, bytes + written, length - written, (off_t)position + (off_t)written);
+
+		if(result < 0) {
+			if(errno == EINTR)
+				continue;
+			return -1;
+		}
+		written += (size_t)result;
+	}
+
+	return (ssize_t)written;
+}
@@ -26,7 +26,7 @@
 #import "AMDJSClass.h"
 #import "AMDBinding.h"
 
-@class AMDDirectory, L8Value;
+@class AMDDirectory, AMDFileHandle, L8Value;
 
 /**
  * @brief A class for manipulating the native file system: JavaScript exports.
@@ -93,6 +93,33 @@ L8_EXPORT_AS(exists,
 + (BOOL)itemExistsAtPath:(NSString *)path
 );
 
+/**
+ * Get the type of the item at specified path.
+ *
+ * Results are cached until the item is changed through this
+ * binding, or the cache is cleared.
+ *
+ * @param path The path to check.
+ * @return 1 for a file, 2 for a directory, 0 if the item does not exist.
+ */
+L8_EXPORT_AS(stat,
++ (int)typeOfItemAtPath:(NSString *)path
+);
+
+/**
+ * Forget all cached item types.
+ *
+ * Use when files were changed outside of the binding.
+ */
++ (void)clearStatCache;
+
+/**
+ * Get the directory with the resources of the game.
+ *
+ * @return Absolute path of the directory.
+ */
++ (NSString *)resourcePath;
+
 /**
  * @section File operations.
  */
@@ -112,14 +139,25 @@ L8_EXPORT_AS(readFile,
  * Write to a file, overwriting the contents.
  *
  * @param path Path of the file.
- * @param data Data for the file.
- * @param encoding Encoding for the file. [utf8,utf16,utf16le,utf16be,bin]
+ * @param data Data for the file: an ArrayBuffer, or a string.
+ * @param encoding Encoding of a string. [utf8,utf16,utf16le,utf16be,base64,hex]
  * @return YES on success, NO on failure.
  */
 L8_EXPORT_AS(writeFile,
 + (BOOL)writeToFile:(NSString *)path data:(L8Value *)data withEncoding:(NSString *)encoding
 );
 
+/**
+ * Open a file for reading and writing in parts.
+ *
+ * @param path Path of the file.
+ * @param flags Like fopen(). [r,r+,w,w+,a,a+]
+ * @return The file, or null on failure.
+ */
+L8_EXPORT_AS(open,
++ (L8Value *)openFileAtPath:(NSString *)path flags:(NSString *)flags
+);
+
 @end
 
 /**
@@ -24,18 +24,52 @@
  */
 
 #import "AMDFileSystem.h"
+#import "AMDFileWatcher.h"
+#import "AMDArrayBuffer.h"
+#import "AMDFileHandle.h"
+
+#include <sys/stat.h>
+
+AMD_REGISTER_BINDING(AMDFileSystem, "fs");
+
+/// Item types returned by stat.
+typedef enum {
+	AMD_FS_TYPE_NONE = 0,
+	AMD_FS_TYPE_FILE = 1,
+	AMD_FS_TYPE_DIRECTORY = 2
+} amd_fs_type_t;
+
+static NSMutableDictionary *amd_fs_stat_cache; // Path -> NSNumber
+
+/**
+ * Forget the cached type of a path, and of everything below it.
+ *
+ * @param path The changed path.
+ */
+static void amd_fs_invalidate_stat_cache(NSString *path);
 
 @implementation AMDFileSystem
 
-+ (L8Value *)setUpBinding
++ (void)initialize
 {
-	return [L8Value valueWithObject:[AMDFileSystem class]
-						  inContext:[L8Context currentContext]];
+	if(self != [AMDFileSystem class])
+		return;
+
+	amd_fs_stat_cache = [[NSMutableDictionary alloc] init];
+
+	[[NSNotificationCenter defaultCenter] addObserverForName:AMDFilesDidChangeNotification
+													  object:nil
+													   queue:nil
+												  usingBlock:^(NSNotification *notification) {
+		for(NSString *path in notification.userInfo[AMDFileWatcherPathsKey])
+			amd_fs_invalidate_stat_cache(path);
+	}];
 }
 
-+ (NSString *)bindingName
++ (L8Value *)setUpBinding
 {
-	return @"fs";
+	return [L8Value valueWithObject:[AMDFileSystem class]
+						  inContext:[L8Context currentContext]];
 }
 
 + (NSStringEncoding)stringEncodingForEncoding:(NSString *)encoding
@@ -54,7 +88,7 @@
 		return NSUTF32StringEncoding;
 	if([encoding isEqualToString:@"utf32le"])
 		return NSUTF32LittleEndianStringEncoding;
-	if([encoding isEqualToString:@"utd32be"])
+	if([encoding isEqualToString:@"utf32be"])
 		return NSUTF32BigEndianStringEncoding;
 	return 0;
 }
@@ -86,6 +120,7 @@
 	fileManager = [NSFileManager defaultManager];
 	path = [path stringByExpandingTildeInPath];
 
+	amd_fs_invalidate_stat_cache(path);
 	if(![fileManager createDirectoryAtPath:path // TODO resolve
 		   withIntermediateDirectories:YES
 							attributes:nil
@@ -104,6 +139,7 @@
 	fileManager = [NSFileManager defaultManager];
 	path = [path stringByExpandingTildeInPath];
 
+	amd_fs_invalidate_stat_cache(path);
 	if(![fileManager removeItemAtPath:path // TODO resolve
 							error:&error])
 		return NO;
@@ -120,6 +156,8 @@
 	from = [from stringByExpandingTildeInPath];
 	to = [to stringByExpandingTildeInPath];
 
+	amd_fs_invalidate_stat_cache(from);
+	amd_fs_invalidate_stat_cache(to);
 	if(![fileManager moveItemAtPath:from // TODO resolve
 							 toPath:to // TODO resolve
 								error:&error])
@@ -138,6 +176,45 @@
 	return [fileManager fileExistsAtPath:path];
 }
 
++ (int)typeOfItemAtPath:(NSString *)path
+{
+	NSNumber *type;
+	struct stat info;
+
+	path = [path stringByExpandingTildeInPath];
+
+	@synchronized(amd_fs_stat_cache) {
+		type = amd_fs_stat_cache[path];
+	}
+	if(type != nil)
+		return type.intValue;
+
+	if(stat(path.fileSystemRepresentation, &info) != 0)
+		type = @(AMD_FS_TYPE_NONE);
+	else if(S_ISDIR(info.st_mode))
+		type = @(AMD_FS_TYPE_DIRECTORY);
+	else
+		type = @(AMD_FS_TYPE_FILE);
+
+	@synchronized(amd_fs_stat_cache) {
+		amd_fs_stat_cache[path] = type;
+	}
+
+	return type.intValue;
+}
+
++ (void)clearStatCache
+{
+	@synchronized(amd_fs_stat_cache) {
+		[amd_fs_stat_cache removeAllObjects];
+	}
+}
+
++ (NSString *)resourcePath
+{
+	return [[NSBundle mainBundle] resourcePath];
+}
+
 #pragma mark - File operations
 
 + (L8Value *)contentsOfFileAtPath:(NSString *)path withEncoding:(NSString *)encoding
@@ -153,9 +230,18 @@
 	}
 
 	if([encoding isEqualToString:@"bin"]) {
+		// Mapped, so the buffer is the only copy
 		data = [NSData dataWithContentsOfFile:path
-									  options:NSDataReadingUncached
+									  options:NSDataReadingMappedIfSafe
 										error:&error];
+		data = [AMDArrayBuffer arrayBufferWithData:data];
+	} else if([encoding isEqualToString:@"utf8"]) {
+		// Decoded by AMDUnicode, not by NSString
+		data = [NSData dataWithContentsOfFile:path
+									  options:NSDataReadingMappedIfSafe
+										error:&error];
+		if(data != nil)
+			return [AMDArrayBuffer stringValueWithUTF8Data:data];
 	} else {
 		data = [NSString stringWithContentsOfFile:path
 										 encoding:[self stringEncodingForEncoding:encoding]
@@ -170,8 +256,63 @@
 
 + (BOOL)writeToFile:(NSString *)path data:(L8Value *)data withEncoding:(NSString *)encoding
 {
-	// TODO
-	return NO;
+	L8ArrayBuffer *buffer;
+	NSData *contents;
+	NSError *error;
+
+	path = [path stringByExpandingTildeInPath];
+
+	if([data isArrayBuffer])
+		buffer = [data toArrayBuffer];
+	else
+		buffer = [AMDArrayBuffer arrayBufferFromString:[data toString]
+											  encoding:encoding ?: @"utf8"
+												offset:nil
+												   end:nil];
+	if(buffer == nil)
+		return NO;
+
+	contents = [NSData dataWithBytesNoCopy:buffer.buffer
+									length:buffer.length
+							  freeWhenDone:NO];
+
+	if(![contents writeToFile:path options:NSDataWritingAtomic error:&error]) {
+		NSLog(@"Failed to write %@: %@",path,error);
+		return NO;
+	}
+
+	amd_fs_invalidate_stat_cache(path);
+
+	return YES;
+}
+
++ (L8Value *)openFileAtPath:(NSString *)path flags:(NSString *)flags
+{
+	AMDFileHandle *file;
+
+	path = [path stringByExpandingTildeInPath];
+	file = [[AMDFileHandle alloc] initWithPath:path flags:flags ?: @"r"];
+	if(file == nil)
+		return [L8Value valueWithNullInContext:[L8Context currentContext]];
+
+	// Opening can create the file
+	amd_fs_invalidate_stat_cache(path);
+
+	return [L8Value valueWithObject:file inContext:[L8Context currentContext]];
 }
 
 @end
+
+static void amd_fs_invalidate_stat_cache(NSString *path)
+{
+	NSString *prefix = [path stringByAppendingString:@"/"];
+
+	@synchronized(amd_fs_stat_cache) {
+		NSSet *paths;
+
+		paths = [amd_fs_stat_cache keysOfEntriesPassingTest:^BOOL(NSString *key, id obj, BOOL *stop) {
+			return [key isEqualToString:path] || [key hasPrefix:prefix];
+		}];
+		[amd_fs_stat_cache removeObjectsForKeys:paths.allObjects];
+	}
+}
@@ -30,6 +30,8 @@
 
 #import <L8Framework/L8.h>
 
+AMD_REGISTER_BINDING(AMDHashing, "hashing");
+
 @implementation AMDHashing
 
 + (L8Value *)setUpBinding
@@ -38,11 +40,6 @@
 						  inContext:[L8Context currentContext]];
 }
 
-+ (NSString *)bindingName
-{
-	return @"hashing";
-}
-
 + (NSString *)dataHashOfData:(L8Value *)data withAlgorithm:(NSString *)algorithm
 {
 	id dataObject;
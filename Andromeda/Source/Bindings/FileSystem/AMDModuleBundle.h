@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDBinding.h"
+
+/// Magic number of a module bundle: 'AMDB'.
+#define AMD_MODULE_BUNDLE_MAGIC		0x42444D41
+
+/// Version of the module bundle format.
+#define AMD_MODULE_BUNDLE_VERSION	1
+
+/// Header of a module bundle. Followed by the index.
+typedef struct __attribute__((packed)) amd_module_bundle_header_s {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t reserved;
+	uint32_t numberOfModules;
+} amd_module_bundle_header_t;
+
+/// Index entry of a module bundle. Offsets are from the start of the file.
+typedef struct __attribute__((packed)) amd_module_bundle_entry_s {
+	/// Path relative to the resources of the game, UTF-8.
+	uint32_t pathOffset;
+	uint32_t pathLength;
+	/// Contents of the module.
+	uint32_t dataOffset;
+	uint32_t dataLength;
+} amd_module_bundle_entry_t;
+
+/**
+ * @brief Module bundle binding: JavaScript exports.
+ */
+@protocol AMDModuleBundle <L8Export>
+
+/**
+ * Get the type of a path in the bundle.
+ *
+ * @param path Absolute path.
+ * @return 1 for a module, 2 for a directory with modules, 0 if the
+ * path is not in the bundle.
+ */
+L8_EXPORT_AS(stat,
++ (int)typeOfItemAtPath:(NSString *)path
+);
+
+/**
+ * Get the source of a module in the bundle.
+ *
+ * @param path Absolute path of the module.
+ * @return The source, or null if the module is not in the bundle.
+ */
+L8_EXPORT_AS(read,
++ (NSString *)sourceOfModuleAtPath:(NSString *)path
+);
+
+/**
+ * Write a bundle with modules.
+ *
+ * @param path Path of the bundle.
+ * @param filenames Absolute paths of the modules, within the
+ * resources of the game.
+ * @return YES on success, NO on failure.
+ */
+L8_EXPORT_AS(write,
++ (BOOL)writeBundleToPath:(NSString *)path withModules:(NSArray *)filenames
+);
+
+/**
+ * Path to build a bundle at instead of running the game.
+ *
+ * @return The path, or nil for a normal run.
+ */
++ (NSString *)buildPath;
+
+@end
+
+/**
+ * @brief A bundle of modules, read with a single mapping.
+ *
+ * Shipped games put all their modules in modules.amdbundle in their
+ * resources. When the bundle exists, the module loader reads modules
+ * from it instead of from the file system. Modules keep their original
+ * filename, so stack traces do not change.
+ *
+ * A bundle with every module reachable from the main module is built
+ * with the headless runner and --build-bundle=PATH.
+ */
+@interface AMDModuleBundle : NSObject <AMDModuleBundle, AMDBinding>
+
+/**
+ * Set the path to build a bundle at instead of running the game.
+ *
+ * @param path The path, or nil for a normal run.
+ */
++ (void)setBuildPath:(NSString *)path;
+
+/**
+ * Initialize with a bundle file.
+ *
+ * @param path Path of the bundle.
+ * @param rootPath Directory the paths in the bundle are relative to.
+ * @return self, or nil if the bundle can't be read or is invalid.
+ */
+- (instancetype)initWithContentsOfFile:(NSString *)path rootPath:(NSString *)rootPath;
+
+/**
+ * Get the contents of a module.
+ *
+ * The data points into the mapped bundle.
+ *
+ * @param path Absolute path of the module.
+ * @return The contents, or nil if the module is not in the bundle.
+ */
+- (NSData *)dataForModuleAtPath:(NSString *)path;
+
+/**
+ * Find whether a directory contains modules in the bundle.
+ *
+ * @param path Absolute path of the directory.
+ * @return YES if it does, NO otherwise.
+ */
+- (BOOL)containsDirectoryAtPath:(NSString *)path;
+
+@end
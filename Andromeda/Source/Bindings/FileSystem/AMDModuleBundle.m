@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDModuleBundle.h"
+
+#import <L8Framework/L8.h>
+
+AMD_REGISTER_BINDING(AMDModuleBundle, "bundle");
+
+static NSString *amd_module_bundle_build_path;
+
+/**
+ * Get the bundle shipped with the game.
+ *
+ * @return The bundle, or nil if the game has none.
+ */
+static AMDModuleBundle *amd_module_bundle_main(void);
+
+/**
+ * Get the path relative to a root directory.
+ *
+ * @param path The absolute path.
+ * @param rootPath The root, without trailing separator.
+ * @return The relative path, or nil if the path is not in the root.
+ */
+static NSString *amd_module_bundle_relative_path(NSString *path, NSString *rootPath);
+
+@implementation AMDModuleBundle {
+	NSData *_data;
+	NSString *_rootPath;
+	NSDictionary *_modules; // Relative path -> NSValue of NSRange
+	NSSet *_directories; // Relative paths
+}
+
++ (L8Value *)setUpBinding
+{
+	return [L8Value valueWithObject:[AMDModuleBundle class]
+						  inContext:[L8Context currentContext]];
+}
+
++ (void)setBuildPath:(NSString *)path
+{
+	amd_module_bundle_build_path = [path copy];
+}
+
++ (NSString *)buildPath
+{
+	return amd_module_bundle_build_path;
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path rootPath:(NSString *)rootPath
+{
+	self = [super init];
+	if(self) {
+		const amd_module_bundle_header_t *header;
+		const amd_module_bundle_entry_t *entries;
+		NSMutableDictionary *modules;
+		NSMutableSet *directories;
+		NSError *error;
+		const uint8_t *bytes;
+		NSUInteger length;
+
+		_data = [NSData dataWithContentsOfFile:path
+									   options:NSDataReadingMappedAlways
+										 error:&error];
+		if(_data == nil) {
+			NSLog(@"Failed to map module bundle %@: %@",path,error);
+			return nil;
+		}
+		_rootPath = [rootPath copy];
+
+		bytes = _data.bytes;
+		length = _data.length;
+
+		header = (const amd_module_bundle_header_t *)bytes;
+		if(length < sizeof(*header)
+		   || header->magic != AMD_MODULE_BUNDLE_MAGIC
+		   || header->version != AMD_MODULE_BUNDLE_VERSION
+		   || (length - sizeof(*header)) / sizeof(*entries) < header->numberOfModules) {
+			NSLog(@"Invalid module bundle %@",path);
+			return nil;
+		}
+
+		entries = (const amd_module_bundle_entry_t *)(bytes + sizeof(*header));
+		modules = [NSMutableDictionary dictionaryWithCapacity:header->numberOfModules];
+		directories = [NSMutableSet set];
+
+		for(uint32_t i = 0; i < header->numberOfModules; ++i) {
+			const amd_module_bundle_entry_t *entry = &entries[i];
+			NSString *modulePath;
+
+			if((uint64_t)entry->pathOffset + entry->pathLength > length
+			   || (uint64_t)entry->dataOffset + entry->dataLength > length) {
+				NSLog(@"Invalid module bundle %@",path);
+				return nil;
+			}
+
+			modulePath = [[NSString alloc] initWithBytes:bytes + entry->pathOffset
+												  length:entry->pathLength
+												encoding:NSUTF8StringEncoding];
+			if(modulePath == nil)
+				continue;
+
+			modules[modulePath] = [NSValue valueWithRange:NSMakeRange(entry->dataOffset, entry->dataLength)];
+
+			// All parents, so directories can be resolved without the file system
+			for(NSString *directory = [modulePath stringByDeletingLastPathComponent];
+				directory.length > 0;
+				directory = [directory stringByDeletingLastPathComponent])
+				[directories addObject:directory];
+		}
+
+		_modules = modules;
+		_directories = directories;
+	}
+	return self;
+}
+
+- (NSData *)dataForModuleAtPath:(NSString *)path
+{
+	NSString *relativePath;
+	NSValue *range;
+
+	relativePath = amd_module_bundle_relative_path(path, _rootPath);
+	if(relativePath == nil)
+		return nil;
+
+	range = _modules[relativePath];
+	if(range == nil)
+		return nil;
+
+	return [_data subdataWithRange:range.rangeValue];
+}
+
+- (BOOL)containsDirectoryAtPath:(NSString *)path
+{
+	NSString *relativePath;
+
+	if([path isEqualToString:_rootPath])
+		return YES;
+
+	relativePath = amd_module_bundle_relative_path(path, _rootPath);
+	return relativePath != nil && [_directories containsObject:relativePath];
+}
+
+#pragma mark - JavaScript
+
++ (int)typeOfItemAtPath:(NSString *)path
+{
+	AMDModuleBundle *bundle = amd_module_bundle_main();
+
+	if([bundle dataForModuleAtPath:path] != nil)
+		return 1;
+	if([bundle containsDirectoryAtPath:path])
+		return 2;
+	return 0;
+}
+
++ (NSString *)sourceOfModuleAtPath:(NSString *)path
+{
+	NSData *data;
+
+	data = [amd_module_bundle_main() dataForModuleAtPath:path];
+	if(data == nil)
+		return nil;
+
+	return [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+}
+
++ (BOOL)writeBundleToPath:(NSString *)path withModules:(NSArray *)filenames
+{
+	NSString *rootPath = [[NSBundle mainBundle] resourcePath];
+	NSMutableData *index, *strings, *bundle;
+	amd_module_bundle_header_t header;
+	amd_module_bundle_entry_t *entries;
+	uint32_t numberOfModules = 0, base;
+	NSError *error;
+
+	index = [NSMutableData data];
+	strings = [NSMutableData data];
+
+	for(NSString *filename in filenames) {
+		NSString *relativePath;
+		NSData *pathData, *contents;
+		amd_module_bundle_entry_t entry;
+
+		relativePath = amd_module_bundle_relative_path(filename, rootPath);
+		if(relativePath == nil) {
+			fprintf(stderr,"[BNDL] Skipping %s: outside of the resources\n",filename.UTF8String);
+			continue;
+		}
+
+		contents = [NSData dataWithContentsOfFile:filename options:0 error:&error];
+		if(contents == nil) {
+			fprintf(stderr,"[BNDL] Failed to read %s: %s\n",
+					filename.UTF8String,error.localizedDescription.UTF8String);
+			return NO;
+		}
+		pathData = [relativePath dataUsingEncoding:NSUTF8StringEncoding];
+
+		// Offsets are made absolute once the size of the index is known
+		entry.pathOffset = (uint32_t)strings.length;
+		entry.pathLength = (uint32_t)pathData.length;
+		[strings appendData:pathData];
+
+		entry.dataOffset = (uint32_t)strings.length;
+		entry.dataLength = (uint32_t)contents.length;
+		[strings appendData:contents];
+
+		[index appendBytes:&entry length:sizeof(entry)];
+		numberOfModules++;
+	}
+
+	base = (uint32_t)(sizeof(header) + index.length);
+	entries = index.mutableBytes;
+	for(uint32_t i = 0; i < numberOfModules; ++i) {
+		entries[i].pathOffset += base;
+		entries[i].dataOffset += base;
+	}
+
+	header.magic = AMD_MODULE_BUNDLE_MAGIC;
+	header.version = AMD_MODULE_BUNDLE_VERSION;
+	header.reserved = 0;
+	header.numberOfModules = numberOfModules;
+
+	bundle = [NSMutableData dataWithBytes:&header length:sizeof(header)];
+	[bundle appendData:index];
+	[bundle appendData:strings];
+
+	if(![bundle writeToFile:[path stringByExpandingTildeInPath]
+					options:NSDataWritingAtomic
+					  error:&error]) {
+		fprintf(stderr,"[BNDL] Failed to write %s: %s\n",
+				path.UTF8String,error.localizedDescription.UTF8String);
+		return NO;
+	}
+
+	fprintf(stdout,"[BNDL] Wrote %u modules to %s\n",numberOfModules,path.UTF8String);
+	return YES;
+}
+
+@end
+
+static AMDModuleBundle *amd_module_bundle_main(void)
+{
+	static AMDModuleBundle *bundle;
+	static dispatch_once_t onceToken;
+
+	dispatch_once(&onceToken, ^{
+		NSString *path;
+
+		// Building a bundle must read the sources
+		if(amd_module_bundle_build_path != nil)
+			return;
+
+		path = [[NSBundle mainBundle] pathForResource:@"modules" ofType:@"amdbundle"];
+		if(path == nil)
+			return;
+
+		bundle = [[AMDModuleBundle alloc] initWithContentsOfFile:path
+														rootPath:[[NSBundle mainBundle] resourcePath]];
+	});
+
+	return bundle;
+}
+
+static NSString *amd_module_bundle_relative_path(NSString *path, NSString *rootPath)
+{
+	NSUInteger length = rootPath.length;
+
+	if(path.length <= length + 1
+	   || ![path hasPrefix:rootPath]
+	   || [path characterAtIndex:length] != '/')
+		return nil;
+
+	return [path substringFromIndex:length + 1];
+}
@@ -27,6 +27,8 @@
 
 #import <L8Framework/L8.h>
 
+AMD_REGISTER_BINDING(AMDPathBinding, "path");
+
 @implementation AMDPathBinding
 
 + (L8Value *)setUpBinding
@@ -35,11 +37,6 @@
 						  inContext:[L8Context currentContext]];
 }
 
-+ (NSString *)bindingName
-{
-	return @"path";
-}
-
 + (NSString *)dirname:(NSString *)path
 {
 	return [path stringByDeletingLastPathComponent];
@@ -28,6 +28,9 @@
 #import "AMDSocket.h"
 
 #import <L8Framework/L8.h>
+#import "L8Value+AMDLazyProperties.h"
+
+AMD_REGISTER_BINDING(AMDNetworking, "net");
 
 @implementation AMDNetworking
 
@@ -38,9 +41,21 @@
 	binding = [L8Value valueWithObject:[AMDNetworking class]
 						  inContext:[L8Context currentContext]];
 
-	binding[@"Bonjour"] = [AMDBonjour class];
-	binding[@"Bonjour"][@"Peer"] = [AMDBonjourPeer class];
-	binding[@"Socket"] = [AMDSocket class];
+	// Wrapping a class is expensive: only do it when used
+	[binding defineLazyProperty:@"Bonjour" withBlock:^id{
+		L8Value *bonjour;
+
+		bonjour = [L8Value valueWithObject:[AMDBonjour class]
+								 inContext:[L8Context currentContext]];
+		[bonjour defineLazyProperty:@"Peer" withBlock:^id{
+			return [AMDBonjourPeer class];
+		}];
+
+		return bonjour;
+	}];
+	[binding defineLazyProperty:@"Socket" withBlock:^id{
+		return [AMDSocket class];
+	}];
 
 	[binding defineProperty:@"localName"
 				 descriptor:@{@"get": ^{
@@ -55,11 +70,6 @@
 	return binding;
 }
 
-+ (NSString *)bindingName
-{
-	return @"net";
-}
-
 #pragma mark - Network
 
 + (NSString *)localName
@@ -73,7 +73,15 @@
 - (void)stop;
 
 L8_EXPORT_AS(on,
-- (void)addEventListener:(NSString *)event function:(L8Value *)function
+- (uint32_t)addEventListener:(NSString *)event function:(L8Value *)function
+);
+
+L8_EXPORT_AS(once,
+- (uint32_t)addOnceEventListener:(NSString *)event function:(L8Value *)function
+);
+
+L8_EXPORT_AS(off,
+- (void)removeEventListeners:(L8Value *)target function:(L8Value *)function
 );
 
 @end
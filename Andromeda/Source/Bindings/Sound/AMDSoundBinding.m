@@ -27,6 +27,9 @@
 #import "AMDSound.h"
 
 #import <L8Framework/L8.h>
+#import "L8Value+AMDLazyProperties.h"
+
+AMD_REGISTER_BINDING(AMDSoundBinding, "sound");
 
 @implementation AMDSoundBinding
 
@@ -39,14 +42,11 @@
 	object = [L8Value valueWithObject:[AMDSoundBinding class]
 							inContext:context];
 
-	object[@"NativeSound"] = [AMDSound class];
+	[object defineLazyProperty:@"NativeSound" withBlock:^id{
+		return [AMDSound class];
+	}];
 
 	return object;
 }
 
-+ (NSString *)bindingName
-{
-	return @"sound";
-}
-
 @end
@@ -26,6 +26,78 @@
 #import "AMDBinding.h"
 #import <L8Framework/L8.h>
 
+@class AMDArrayBufferEncoder, AMDArrayBufferDecoder;
+
+/**
+ * @brief Streaming encoder of ArrayBuffers to strings: JavaScript exports.
+ */
+@protocol AMDArrayBufferEncoder <L8Export>
+
+/**
+ * Encode a chunk.
+ *
+ * @param arrayBuffer Buffer with the bytes.
+ * @param offset Start of the bytes.
+ * @param end End of the bytes.
+ * @return The encoded characters that are complete.
+ */
+L8_EXPORT_AS(write,
+- (NSString *)encodeArrayBuffer:(L8ArrayBuffer *)arrayBuffer
+						 offset:(NSNumber *)offset
+							end:(NSNumber *)end
+);
+
+/**
+ * Finish encoding.
+ *
+ * @return The last characters, including padding.
+ */
+L8_EXPORT_AS(end,
+- (NSString *)finishEncoding
+);
+
+@end
+
+/**
+ * @brief Streaming encoder of ArrayBuffers to strings.
+ */
+@interface AMDArrayBufferEncoder : NSObject <AMDArrayBufferEncoder>
+
+@end
+
+/**
+ * @brief Streaming decoder of strings to ArrayBuffers: JavaScript exports.
+ */
+@protocol AMDArrayBufferDecoder <L8Export>
+
+/**
+ * Decode a chunk.
+ *
+ * @param string The characters.
+ * @return The decoded bytes that are complete.
+ */
+L8_EXPORT_AS(write,
+- (L8ArrayBuffer *)decodeString:(NSString *)string
+);
+
+/**
+ * Finish decoding.
+ *
+ * @return The last bytes.
+ */
+L8_EXPORT_AS(end,
+- (L8ArrayBuffer *)finishDecoding
+);
+
+@end
+
+/**
+ * @brief Streaming decoder of strings to ArrayBuffers.
+ */
+@interface AMDArrayBufferDecoder : NSObject <AMDArrayBufferDecoder>
+
+@end
+
 /**
  * @brief ArrayBuffer utilitiy functions: JavaScript exports.
  */
@@ -34,12 +106,15 @@
 /**
  * Create a string from an ArrayBuffer.
  *
+ * UTF-8 is decoded straight into a string, invalid sequences become
+ * U+FFFD.
+ *
  * @param arrayBuffer The ArrayBuffer to covert.
  * @param encoding The encoding to use.
  * @return The encoded string.
  */
 L8_EXPORT_AS(stringFromArrayBuffer,
-+ (NSString *)stringFromArrayBuffer:(L8ArrayBuffer *)arrayBuffer
++ (L8Value *)stringFromArrayBuffer:(L8ArrayBuffer *)arrayBuffer
 						   encoding:(NSString *)encoding
 							 offset:(NSNumber *)offset
 								end:(NSNumber *)end
@@ -77,6 +152,155 @@ L8_EXPORT_AS(copy,
 						   offset:(NSNumber *)targetStart
 );
 
+/**
+ * Fill a range of an ArrayBuffer with a byte.
+ *
+ * @param buffer Buffer to fill.
+ * @param value The byte, truncated to 8 bits.
+ * @param offset Start of the range.
+ * @param end End of the range.
+ */
+L8_EXPORT_AS(fill,
++ (void)fillBuffer:(L8ArrayBuffer *)buffer
+		 withByte:(NSNumber *)value
+		   offset:(NSNumber *)offset
+			  end:(NSNumber *)end
+);
+
+/**
+ * Fill a range of an ArrayBuffer with a repeated pattern.
+ *
+ * The last repetition is cut off at the end of the range.
+ *
+ * @param buffer Buffer to fill.
+ * @param pattern Bytes to repeat.
+ * @param offset Start of the range.
+ * @param end End of the range.
+ */
+L8_EXPORT_AS(fillPattern,
++ (void)fillBuffer:(L8ArrayBuffer *)buffer
+	  withPattern:(L8ArrayBuffer *)pattern
+		   offset:(NSNumber *)offset
+			  end:(NSNumber *)end
+);
+
+/**
+ * Compare ranges of two ArrayBuffers bytewise.
+ *
+ * @param buffer The first buffer.
+ * @param start Start of the range in the first buffer.
+ * @param end End of the range in the first buffer.
+ * @param otherBuffer The second buffer.
+ * @param otherStart Start of the range in the second buffer.
+ * @param otherEnd End of the range in the second buffer.
+ * @return -1, 0 or 1 when the first range sorts before, equal to
+ * or after the second range.
+ */
+L8_EXPORT_AS(compare,
++ (NSNumber *)compareBuffer:(L8ArrayBuffer *)buffer
+					 offset:(NSNumber *)start
+						end:(NSNumber *)end
+				   toBuffer:(L8ArrayBuffer *)otherBuffer
+					 offset:(NSNumber *)otherStart
+						end:(NSNumber *)otherEnd
+);
+
+/**
+ * Find the first occurrence of a byte in an ArrayBuffer.
+ *
+ * @param buffer Buffer to search in.
+ * @param value The byte, truncated to 8 bits.
+ * @param offset Start of the search.
+ * @param end End of the search.
+ * @return Index of the byte, or -1 if it is not found.
+ */
+L8_EXPORT_AS(indexOf,
++ (NSNumber *)indexOfByte:(NSNumber *)value
+				 inBuffer:(L8ArrayBuffer *)buffer
+				   offset:(NSNumber *)offset
+					  end:(NSNumber *)end
+);
+
+/**
+ * Find the first occurrence of a byte sequence in an ArrayBuffer.
+ *
+ * @param needle Bytes to search for.
+ * @param buffer Buffer to search in.
+ * @param offset Start of the search.
+ * @param end End of the search.
+ * @return Index of the sequence, or -1 if it is not found.
+ */
+L8_EXPORT_AS(indexOfBytes,
++ (NSNumber *)indexOfBytes:(L8ArrayBuffer *)needle
+				  inBuffer:(L8ArrayBuffer *)buffer
+					offset:(NSNumber *)offset
+					   end:(NSNumber *)end
+);
+
+/**
+ * Encode a string into an existing ArrayBuffer.
+ *
+ * Only whole characters are written.
+ *
+ * @param string The string to encode.
+ * @param encoding The encoding to use.
+ * @param buffer Buffer to write to.
+ * @param offset Offset to write at.
+ * @param length Maximum number of bytes to write.
+ * @return The number of bytes written.
+ */
+L8_EXPORT_AS(write,
++ (NSNumber *)writeString:(NSString *)string
+				 encoding:(NSString *)encoding
+				 toBuffer:(L8ArrayBuffer *)buffer
+				   offset:(NSNumber *)offset
+				   length:(NSNumber *)length
+);
+
+/**
+ * Create an ArrayBuffer from a list of octets.
+ *
+ * @param array Numbers, truncated to 8 bits.
+ * @return The new ArrayBuffer.
+ */
+L8_EXPORT_AS(arrayBufferFromArray,
++ (L8ArrayBuffer *)arrayBufferFromArray:(NSArray *)array
+);
+
+/**
+ * Create a list of octets from a range of an ArrayBuffer.
+ *
+ * @param buffer The buffer.
+ * @param offset Start of the range.
+ * @param end End of the range.
+ * @return Array of numbers.
+ */
+L8_EXPORT_AS(arrayFromArrayBuffer,
++ (NSArray *)arrayFromArrayBuffer:(L8ArrayBuffer *)buffer
+						   offset:(NSNumber *)offset
+							  end:(NSNumber *)end
+);
+
+/**
+ * Create a streaming encoder, for data too large to encode at once.
+ *
+ * @param encoding base64, base64url or hex.
+ * @return The encoder.
+ */
+L8_EXPORT_AS(createEncoder,
++ (AMDArrayBufferEncoder *)encoderWithEncoding:(NSString *)encoding
+);
+
+/**
+ * Create a streaming decoder, for data too large to decode at once.
+ *
+ * @param encoding base64, base64url or hex.
+ * @return The decoder.
+ */
+L8_EXPORT_AS(createDecoder,
++ (AMDArrayBufferDecoder *)decoderWithEncoding:(NSString *)encoding
+);
+
 @end
 
 /**
@@ -84,4 +308,23 @@ L8_EXPORT_AS(copy,
  */
 @interface AMDArrayBuffer : NSObject <AMDBinding, AMDArrayBuffer>
 
+/**
+ * Create an ArrayBuffer with a copy of the contents of data.
+ *
+ * @param data The data.
+ * @return The ArrayBuffer, or nil on failure.
+ */
++ (L8ArrayBuffer *)arrayBufferWithData:(NSData *)data;
+
+/**
+ * Create a string from UTF-8 data.
+ *
+ * Invalid sequences become U+FFFD. Decoded without going through
+ * NSString's UTF-8 decoder.
+ *
+ * @param data The UTF-8 data.
+ * @return The string value.
+ */
++ (L8Value *)stringValueWithUTF8Data:(NSData *)data;
+
 @end
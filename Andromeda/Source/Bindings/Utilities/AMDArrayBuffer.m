@@ -25,7 +25,145 @@
 
 #import "AMDArrayBuffer.h"
 #import "AMDFileSystem.h"
-#import "NSData+AMDAdditions.h"
+#import "AMDCodec.h"
+#import "AMDUnicode.h"
+
+AMD_REGISTER_BINDING(AMDArrayBuffer, "arraybuffer");
+
+/// Encodings that NSString does not know, done by AMDCodec.
+typedef enum amd_array_buffer_codec_e : uint8_t {
+	AMD_ARRAY_BUFFER_CODEC_NONE,
+	AMD_ARRAY_BUFFER_CODEC_BASE64,
+	AMD_ARRAY_BUFFER_CODEC_BASE64URL,
+	AMD_ARRAY_BUFFER_CODEC_HEX
+} amd_array_buffer_codec_t;
+
+@interface AMDArrayBufferEncoder ()
+
+/**
+ * Initialize an encoder.
+ *
+ * @param codec The encoding, not NONE.
+ * @return self
+ */
+- (instancetype)initWithCodec:(amd_array_buffer_codec_t)codec;
+
+@end
+
+@interface AMDArrayBufferDecoder ()
+
+/**
+ * Initialize a decoder.
+ *
+ * @param codec The encoding, not NONE.
+ * @return self
+ */
+- (instancetype)initWithCodec:(amd_array_buffer_codec_t)codec;
+
+@end
+
+/**
+ * Create a string from UTF-8.
+ *
+ * @param bytes The UTF-8 bytes.
+ * @param length Number of bytes.
+ * @return The string value.
+ */
+static L8Value *amd_array_buffer_utf8_string(const uint8_t *bytes, size_t length);
+
+/**
+ * Encode a string as UTF-8.
+ *
+ * Unpaired surrogates become U+FFFD.
+ *
+ * @param string The string.
+ * @return The UTF-8 bytes.
+ */
+static NSData *amd_array_buffer_utf8_data(NSString *string);
+
+/**
+ * Get the storage of a string of only ASCII characters.
+ *
+ * @param string The string.
+ * @return The characters, or NULL if the string has other characters
+ * or is not stored as 8 bit characters.
+ */
+static const char *amd_array_buffer_ascii_pointer(NSString *string);
+
+/**
+ * Clamp a range to the bounds of an ArrayBuffer.
+ *
+ * @param buffer The buffer.
+ * @param offset Start of the range, or nil for 0.
+ * @param end End of the range, or nil for the length of the buffer.
+ * @param start Set to the clamped start.
+ * @param stop Set to the clamped end.
+ * @return NO if the range is empty.
+ */
+static BOOL amd_array_buffer_range(L8ArrayBuffer *buffer, NSNumber *offset,
+								   NSNumber *end, size_t *start, size_t *stop);
+
+/**
+ * Find the codec of an encoding NSString does not know.
+ *
+ * @param encoding Name of the encoding.
+ * @return The codec, or AMD_ARRAY_BUFFER_CODEC_NONE.
+ */
+static amd_array_buffer_codec_t amd_array_buffer_codec_for_encoding(NSString *encoding);
+
+/**
+ * Encode bytes into a string.
+ *
+ * The characters are written once, into memory owned by the string.
+ *
+ * @param codec The codec.
+ * @param bytes Bytes to encode.
+ * @param length Number of bytes.
+ * @return The string.
+ */
+static NSString *amd_array_buffer_encode(amd_array_buffer_codec_t codec,
+										 const uint8_t *bytes, size_t length);
+
+/**
+ * Get the characters of a string to decode, as ASCII.
+ *
+ * Uses the storage of the string when possible. Other characters
+ * are replaced, so decoders treat them as invalid.
+ *
+ * @param string The string.
+ * @return The characters, valid as long as the string.
+ */
+static NSData *amd_array_buffer_ascii_characters(NSString *string);
+
+/**
+ * Get the maximum length of decoded characters.
+ *
+ * @param codec The codec.
+ * @param length Number of characters.
+ * @return The maximum number of bytes.
+ */
+static size_t amd_array_buffer_decoded_length(amd_array_buffer_codec_t codec, size_t length);
+
+/**
+ * Decode characters.
+ *
+ * @param codec The codec.
+ * @param out Output of amd_array_buffer_decoded_length() bytes.
+ * @param characters The characters.
+ * @return Number of bytes written.
+ */
+static size_t amd_array_buffer_decode(amd_array_buffer_codec_t codec, uint8_t *out,
+									  NSData *characters);
+
+/**
+ * Decode a string with an encoding NSString does not know.
+ *
+ * @param string The string.
+ * @param encoding Name of the encoding.
+ * @return The decoded bytes.
+ */
+static NSData *amd_array_buffer_data_for_custom_encoding(NSString *string,
+														 NSString *encoding);
 
 @implementation AMDArrayBuffer
 
@@ -35,17 +173,13 @@
 						  inContext:[L8Context currentContext]];
 }
 
-+ (NSString *)bindingName
-{
-	return @"arraybuffer";
-}
-
-+ (NSString *)stringFromArrayBuffer:(L8ArrayBuffer *)arrayBuffer
++ (L8Value *)stringFromArrayBuffer:(L8ArrayBuffer *)arrayBuffer
 						   encoding:(NSString *)encoding
 							 offset:(NSNumber *)offset
 								end:(NSNumber *)end
 {
 	NSData *data;
+	NSString *string;
 	size_t loffset, lend;
 	NSStringEncoding eEncoding;
 
@@ -56,24 +190,32 @@
 		return nil;
 	if(lend > arrayBuffer.length)
 		return nil;
-
-	data = [NSData dataWithBytesNoCopy:(uint8_t *)arrayBuffer.buffer + loffset
-								length:lend - loffset + 1
-						  freeWhenDone:NO];
+	if(lend < loffset)
+		lend = loffset;
 
 	eEncoding = [AMDFileSystem stringEncodingForEncoding:encoding];
 	if(eEncoding == 0) {
 		// Custom encodings
-		if([encoding isEqualToString:@"base64"]) {
-			return [data base64EncodedStringWithOptions:0];
-		} else if([encoding isEqualToString:@"hex"]) {
-			return [data hexadecimalString];
-		} else
+		amd_array_buffer_codec_t codec = amd_array_buffer_codec_for_encoding(encoding);
+
+		if(codec == AMD_ARRAY_BUFFER_CODEC_NONE)
 			@throw [L8TypeErrorException exceptionWithMessage:@"No such encoding."];
+
+		string = amd_array_buffer_encode(codec, (uint8_t *)arrayBuffer.buffer + loffset,
+										 lend - loffset);
+		return [L8Value valueWithObject:string inContext:[L8Context currentContext]];
+	} else if(eEncoding == NSUTF8StringEncoding) {
+		return amd_array_buffer_utf8_string((uint8_t *)arrayBuffer.buffer + loffset,
+											lend - loffset);
 	}
 
-	return [[NSString alloc] initWithData:data
-								 encoding:eEncoding];
+	data = [NSData dataWithBytesNoCopy:(uint8_t *)arrayBuffer.buffer + loffset
+								length:lend - loffset
+						  freeWhenDone:NO];
+	string = [[NSString alloc] initWithData:data
+								   encoding:eEncoding];
+
+	return string ? [L8Value valueWithObject:string inContext:[L8Context currentContext]] : nil;
 }
 
 + (L8ArrayBuffer *)arrayBufferFromString:(NSString *)string
@@ -85,21 +227,14 @@
 	NSStringEncoding eEncoding;
 
 	eEncoding = [AMDFileSystem stringEncodingForEncoding:encoding];
-	if(eEncoding == 0) {
-		// Custom encodings
-		if([encoding isEqualToString:@"base64"]) {
-			data = [NSData alloc];
-			data = 	[data initWithBase64EncodedString:string
-											  options:NSDataBase64DecodingIgnoreUnknownCharacters];
-		} else if([encoding isEqualToString:@"hex"]) {
-			// TODO hex encoding
-			return nil;
-		} else
-			@throw [L8TypeErrorException exceptionWithMessage:@"No such encoding."];
-	} else
+	if(eEncoding == 0)
+		data = amd_array_buffer_data_for_custom_encoding(string, encoding);
+	else if(eEncoding == NSUTF8StringEncoding)
+		data = amd_array_buffer_utf8_data(string);
+	else
 		data = [string dataUsingEncoding:eEncoding];
 
-	return [[L8ArrayBuffer alloc] initWithData:data];
+	return [self arrayBufferWithData:data];
 }
 
 + (NSNumber *)copyBytesFromBuffer:(L8ArrayBuffer *)sourceBuffer
@@ -121,4 +256,533 @@
 	return @(toCopy);
 }
 
++ (void)fillBuffer:(L8ArrayBuffer *)buffer
+		 withByte:(NSNumber *)value
+		   offset:(NSNumber *)offset
+			  end:(NSNumber *)end
+{
+	size_t start, stop;
+
+	if(!amd_array_buffer_range(buffer, offset, end, &start, &stop))
+		return;
+
+	memset((uint8_t *)buffer.buffer + start, value.intValue & 0xFF, stop - start);
+}
+
++ (void)fillBuffer:(L8ArrayBuffer *)buffer
+	  withPattern:(L8ArrayBuffer *)pattern
+		   offset:(NSNumber *)offset
+			  end:(NSNumber *)end
+{
+	size_t start, stop, filled, length;
+	uint8_t *bytes;
+
+	if(!amd_array_buffer_range(buffer, offset, end, &start, &stop))
+		return;
+
+	length = stop - start;
+	if(pattern.length == 0)
+		@throw [L8TypeErrorException exceptionWithMessage:@"Fill pattern must not be empty."];
+	if(pattern.length == 1) {
+		memset((uint8_t *)buffer.buffer + start, *(uint8_t *)pattern.buffer, length);
+		return;
+	}
+
+	// Copy the pattern once, then keep doubling the filled part
+	bytes = (uint8_t *)buffer.buffer + start;
+	filled = MIN(pattern.length, length);
+	memmove(bytes, pattern.buffer, filled);
+
+	while(filled < length) {
+		size_t chunk = MIN(filled, length - filled);
+
+		memcpy(bytes + filled, bytes, chunk);
+		filled += chunk;
+	}
+}
+
++ (NSNumber *)compareBuffer:(L8ArrayBuffer *)buffer
+					 offset:(NSNumber *)start
+						end:(NSNumber *)end
+				   toBuffer:(L8ArrayBuffer *)otherBuffer
+					 offset:(NSNumber *)otherStart
+						end:(NSNumber *)otherEnd
+{
+	size_t lstart, lend, otherLstart, otherLend, length, otherLength;
+	int result;
+
+	if(!amd_array_buffer_range(buffer, start, end, &lstart, &lend))
+		lstart = lend = 0;
+	if(!amd_array_buffer_range(otherBuffer, otherStart, otherEnd, &otherLstart, &otherLend))
+		otherLstart = otherLend = 0;
+
+	length = lend - lstart;
+	otherLength = otherLend - otherLstart;
+
+	result = memcmp((uint8_t *)buffer.buffer + lstart,
+					(uint8_t *)otherBuffer.buffer + otherLstart,
+					MIN(length, otherLength));
+
+	// The shorter range sorts first when it is a prefix of the other
+	if(result == 0)
+		result = (length > otherLength) - (length < otherLength);
+
+	return @(result < 0 ? -1 : result > 0);
+}
+
++ (NSNumber *)indexOfByte:(NSNumber *)value
+				 inBuffer:(L8ArrayBuffer *)buffer
+				   offset:(NSNumber *)offset
+					  end:(NSNumber *)end
+{
+	size_t start, stop;
+	uint8_t *bytes, *found;
+
+	if(!amd_array_buffer_range(buffer, offset, end, &start, &stop))
+		return @(-1);
+
+	bytes = buffer.buffer;
+	found = memchr(bytes + start, value.intValue & 0xFF, stop - start);
+
+	return found ? @(found - bytes) : @(-1);
+}
+
++ (NSNumber *)indexOfBytes:(L8ArrayBuffer *)needle
+				  inBuffer:(L8ArrayBuffer *)buffer
+					offset:(NSNumber *)offset
+					   end:(NSNumber *)end
+{
+	size_t start, stop;
+	uint8_t *bytes, *found;
+
+	if(!amd_array_buffer_range(buffer, offset, end, &start, &stop))
+		return @(-1);
+	if(needle.length == 0)
+		return @(start);
+	if(needle.length > stop - start)
+		return @(-1);
+
+	bytes = buffer.buffer;
+	found = memmem(bytes + start, stop - start, needle.buffer, needle.length);
+
+	return found ? @(found - bytes) : @(-1);
+}
+
++ (NSNumber *)writeString:(NSString *)string
+				 encoding:(NSString *)encoding
+				 toBuffer:(L8ArrayBuffer *)buffer
+				   offset:(NSNumber *)offset
+				   length:(NSNumber *)length
+{
+	NSStringEncoding eEncoding;
+	amd_array_buffer_codec_t codec;
+	size_t start, maxLength;
+	NSUInteger used = 0;
+	NSData *data, *characters;
+
+	start = offset.unsignedLongValue;
+	if(start >= buffer.length)
+		return @0;
+
+	maxLength = buffer.length - start;
+	if(length != nil)
+		maxLength = MIN(maxLength, length.unsignedLongValue);
+
+	eEncoding = [AMDFileSystem stringEncodingForEncoding:encoding];
+	if(eEncoding != 0) {
+		// Encodes straight into the buffer, stopping at the last whole character
+		[string getBytes:(uint8_t *)buffer.buffer + start
+			   maxLength:maxLength
+			  usedLength:&used
+				encoding:eEncoding
+				 options:0
+				   range:NSMakeRange(0, string.length)
+		  remainingRange:NULL];
+		return @(used);
+	}
+
+	// Decode straight into the buffer when all of it fits
+	codec = amd_array_buffer_codec_for_encoding(encoding);
+	characters = amd_array_buffer_ascii_characters(string);
+	if(codec != AMD_ARRAY_BUFFER_CODEC_NONE
+	   && amd_array_buffer_decoded_length(codec, characters.length) <= maxLength)
+		return @(amd_array_buffer_decode(codec, (uint8_t *)buffer.buffer + start, characters));
+
+	data = amd_array_buffer_data_for_custom_encoding(string, encoding);
+	used = MIN(data.length, maxLength);
+	memcpy((uint8_t *)buffer.buffer + start, data.bytes, used);
+
+	return @(used);
+}
+
++ (L8ArrayBuffer *)arrayBufferFromArray:(NSArray *)array
+{
+	NSMutableData *data;
+	uint8_t *bytes;
+	NSUInteger i = 0;
+
+	data = [NSMutableData dataWithLength:array.count];
+	bytes = data.mutableBytes;
+
+	for(id value in array) {
+		if([value isKindOfClass:[NSNumber class]])
+			bytes[i] = [value intValue] & 0xFF;
+		++i;
+	}
+
+	return [self arrayBufferWithData:data];
+}
+
++ (NSArray *)arrayFromArrayBuffer:(L8ArrayBuffer *)buffer
+						   offset:(NSNumber *)offset
+							  end:(NSNumber *)end
+{
+	NSMutableArray *array;
+	size_t start, stop;
+	const uint8_t *bytes;
+
+	if(!amd_array_buffer_range(buffer, offset, end, &start, &stop))
+		return @[];
+
+	array = [NSMutableArray arrayWithCapacity:stop - start];
+	bytes = buffer.buffer;
+	for(size_t i = start; i < stop; ++i)
+		[array addObject:@(bytes[i])];
+
+	return array;
+}
+
++ (AMDArrayBufferEncoder *)encoderWithEncoding:(NSString *)encoding
+{
+	amd_array_buffer_codec_t codec = amd_array_buffer_codec_for_encoding(encoding);
+
+	if(codec == AMD_ARRAY_BUFFER_CODEC_NONE)
+		@throw [L8TypeErrorException exceptionWithMessage:@"No such encoding."];
+
+	return [[AMDArrayBufferEncoder alloc] initWithCodec:codec];
+}
+
++ (AMDArrayBufferDecoder *)decoderWithEncoding:(NSString *)encoding
+{
+	amd_array_buffer_codec_t codec = amd_array_buffer_codec_for_encoding(encoding);
+
+	if(codec == AMD_ARRAY_BUFFER_CODEC_NONE)
+		@throw [L8TypeErrorException exceptionWithMessage:@"No such encoding."];
+
+	return [[AMDArrayBufferDecoder alloc] initWithCodec:codec];
+}
+
+#pragma mark - Native
+
++ (L8ArrayBuffer *)arrayBufferWithData:(NSData *)data
+{
+	if(data == nil)
+		return nil;
+
+	return [[L8ArrayBuffer alloc] initWithData:data];
+}
+
++ (L8Value *)stringValueWithUTF8Data:(NSData *)data
+{
+	return amd_array_buffer_utf8_string(data.bytes, data.length);
+}
+
+@end
+
+@implementation AMDArrayBufferEncoder {
+	amd_array_buffer_codec_t _codec;
+	amd_base64_encoder_t _encoder;
+}
+
+- (instancetype)initWithCodec:(amd_array_buffer_codec_t)codec
+{
+	self = [super init];
+	if(self) {
+		_codec = codec;
+		amd_base64_encoder_init(&_encoder, codec == AMD_ARRAY_BUFFER_CODEC_BASE64URL
+								? AMD_BASE64_URL : AMD_BASE64_STANDARD);
+	}
+	return self;
+}
+
+- (NSString *)encodeArrayBuffer:(L8ArrayBuffer *)arrayBuffer
+						 offset:(NSNumber *)offset
+							end:(NSNumber *)end
+{
+	size_t start, stop, length;
+	char *characters;
+
+	if(!amd_array_buffer_range(arrayBuffer, offset, end, &start, &stop))
+		return @"";
+
+	// Hex has no groups to carry over
+	if(_codec == AMD_ARRAY_BUFFER_CODEC_HEX)
+		return amd_array_buffer_encode(_codec, (uint8_t *)arrayBuffer.buffer + start, stop - start);
+
+	characters = malloc(amd_base64_encoded_length(stop - start + 2, AMD_BASE64_STANDARD));
+	if(characters == NULL)
+		@throw [L8RangeErrorException exceptionWithMessage:@"Not enough memory to encode."];
+
+	length = amd_base64_encoder_update(&_encoder, characters,
+									   (uint8_t *)arrayBuffer.buffer + start, stop - start);
+
+	return [[NSString alloc] initWithBytesNoCopy:characters
+										  length:length
+										encoding:NSASCIIStringEncoding
+									freeWhenDone:YES];
+}
+
+- (NSString *)finishEncoding
+{
+	char characters[4];
+	size_t length;
+
+	if(_codec == AMD_ARRAY_BUFFER_CODEC_HEX)
+		return @"";
+
+	length = amd_base64_encoder_final(&_encoder, characters);
+
+	return [[NSString alloc] initWithBytes:characters
+									length:length
+								  encoding:NSASCIIStringEncoding];
+}
+
+@end
+
+@implementation AMDArrayBufferDecoder {
+	amd_array_buffer_codec_t _codec;
+	amd_codec_decoder_t _decoder;
+}
+
+- (instancetype)initWithCodec:(amd_array_buffer_codec_t)codec
+{
+	self = [super init];
+	if(self) {
+		_codec = codec;
+		amd_codec_decoder_init(&_decoder);
+	}
+	return self;
+}
+
+- (L8ArrayBuffer *)decodeString:(NSString *)string
+{
+	NSData *characters;
+	NSMutableData *data;
+	size_t length;
+
+	characters = amd_array_buffer_ascii_characters(string);
+
+	// Room for the group carried over from the previous chunk
+	data = [NSMutableData dataWithLength:amd_array_buffer_decoded_length(_codec, characters.length) + 3];
+	if(_codec == AMD_ARRAY_BUFFER_CODEC_HEX)
+		length = amd_hex_decoder_update(&_decoder, data.mutableBytes,
+										characters.bytes, characters.length);
+	else
+		length = amd_base64_decoder_update(&_decoder, data.mutableBytes,
+										   characters.bytes, characters.length);
+	data.length = length;
+
+	return [AMDArrayBuffer arrayBufferWithData:data];
+}
+
+- (L8ArrayBuffer *)finishDecoding
+{
+	uint8_t bytes[2];
+	size_t length = 0;
+
+	// A lone hex digit is dropped
+	if(_codec != AMD_ARRAY_BUFFER_CODEC_HEX)
+		length = amd_base64_decoder_final(&_decoder, bytes);
+
+	return [[L8ArrayBuffer alloc] initWithData:[NSData dataWithBytes:bytes length:length]];
+}
+
 @end
+
+static BOOL amd_array_buffer_range(L8ArrayBuffer *buffer, NSNumber *offset,
+								   NSNumber *end, size_t *start, size_t *stop)
+{
+	size_t length = buffer.length;
+
+	*start = offset == nil ? 0 : MIN((size_t)MAX(offset.longLongValue, 0), length);
+	*stop = end == nil ? length : MIN((size_t)MAX(end.longLongValue, 0), length);
+
+	return *start < *stop;
+}
+
+static amd_array_buffer_codec_t amd_array_buffer_codec_for_encoding(NSString *encoding)
+{
+	if([encoding isEqualToString:@"base64"])
+		return AMD_ARRAY_BUFFER_CODEC_BASE64;
+	else if([encoding isEqualToString:@"base64url"])
+		return AMD_ARRAY_BUFFER_CODEC_BASE64URL;
+	else if([encoding isEqualToString:@"hex"])
+		return AMD_ARRAY_BUFFER_CODEC_HEX;
+
+	return AMD_ARRAY_BUFFER_CODEC_NONE;
+}
+
+static NSString *amd_array_buffer_encode(amd_array_buffer_codec_t codec,
+										 const uint8_t *bytes, size_t length)
+{
+	amd_base64_alphabet_t alphabet;
+	size_t encodedLength;
+	char *characters;
+
+	if(length == 0)
+		return @"";
+
+	alphabet = codec == AMD_ARRAY_BUFFER_CODEC_BASE64URL ? AMD_BASE64_URL : AMD_BASE64_STANDARD;
+	if(codec == AMD_ARRAY_BUFFER_CODEC_HEX)
+		encodedLength = length * 2;
+	else
+		encodedLength = amd_base64_encoded_length(length, alphabet);
+
+	characters = malloc(encodedLength);
+	if(characters == NULL)
+		@throw [L8RangeErrorException exceptionWithMessage:@"Not enough memory to encode."];
+
+	if(codec == AMD_ARRAY_BUFFER_CODEC_HEX)
+		amd_hex_encode(characters, bytes, length);
+	else
+		amd_base64_encode(characters, bytes, length, alphabet);
+
+	return [[NSString alloc] initWithBytesNoCopy:characters
+										  length:encodedLength
+										encoding:NSASCIIStringEncoding
+									freeWhenDone:YES];
+}
+
+static NSData *amd_array_buffer_ascii_characters(NSString *string)
+{
+	const char *characters;
+	NSMutableData *data;
+	NSUInteger length;
+
+	characters = amd_array_buffer_ascii_pointer(string);
+	if(characters != NULL)
+		return [NSData dataWithBytesNoCopy:(void *)characters
+									length:string.length
+							  freeWhenDone:NO];
+
+	data = [NSMutableData dataWithLength:string.length];
+	[string getBytes:data.mutableBytes
+		   maxLength:data.length
+		  usedLength:&length
+			encoding:NSASCIIStringEncoding
+			 options:NSStringEncodingConversionAllowLossy
+			   range:NSMakeRange(0, string.length)
+	  remainingRange:NULL];
+	data.length = length;
+
+	return data;
+}
+
+static size_t amd_array_buffer_decoded_length(amd_array_buffer_codec_t codec, size_t length)
+{
+	if(codec == AMD_ARRAY_BUFFER_CODEC_HEX)
+		return length / 2;
+	return amd_base64_decoded_length(length);
+}
+
+static size_t amd_array_buffer_decode(amd_array_buffer_codec_t codec, uint8_t *out,
+									  NSData *characters)
+{
+	if(codec == AMD_ARRAY_BUFFER_CODEC_HEX)
+		return amd_hex_decode(out, characters.bytes, characters.length);
+	return amd_base64_decode(out, characters.bytes, characters.length);
+}
+
+static NSData *amd_array_buffer_data_for_custom_encoding(NSString *string,
+														 NSString *encoding)
+{
+	amd_array_buffer_codec_t codec;
+	NSMutableData *data;
+	NSData *characters;
+
+	codec = amd_array_buffer_codec_for_encoding(encoding);
+	if(codec == AMD_ARRAY_BUFFER_CODEC_NONE)
+		@throw [L8TypeErrorException exceptionWithMessage:@"No such encoding."];
+
+	characters = amd_array_buffer_ascii_characters(string);
+	data = [NSMutableData dataWithLength:amd_array_buffer_decoded_length(codec, characters.length)];
+	data.length = amd_array_buffer_decode(codec, data.mutableBytes, characters);
+
+	return data;
+}
+
+static L8Value *amd_array_buffer_utf8_string(const uint8_t *bytes, size_t length)
+{
+	L8Context *context = [L8Context currentContext];
+	NSString *string;
+	uint16_t *characters;
+	size_t units;
+
+	// ASCII needs no decoding at all
+	if(amd_ascii_length(bytes, length) == length) {
+		string = [[NSString alloc] initWithBytes:bytes
+										  length:length
+										encoding:NSASCIIStringEncoding];
+		return [L8Value valueWithObject:string inContext:context];
+	}
+
+	units = amd_utf8_utf16_length(bytes, length);
+
+	characters = malloc(units * sizeof(uint16_t));
+	if(characters == NULL)
+		@throw [L8RangeErrorException exceptionWithMessage:@"Not enough memory to decode."];
+	amd_utf8_to_utf16(characters, bytes, length);
+
+	string = [[NSString alloc] initWithCharactersNoCopy:characters
+												 length:units
+										   freeWhenDone:YES];
+
+	return [L8Value valueWithObject:string inContext:context];
+}
+
+static NSData *amd_array_buffer_utf8_data(NSString *string)
+{
+	const char *ascii;
+	const uint16_t *characters;
+	uint16_t *copiedCharacters = NULL;
+	NSMutableData *data;
+	NSUInteger length = string.length;
+
+	ascii = amd_array_buffer_ascii_pointer(string);
+	if(ascii != NULL)
+		return [NSData dataWithBytes:ascii length:length];
+
+	// Use the UTF-16 storage of the string when it has one
+	characters = (const uint16_t *)CFStringGetCharactersPtr((__bridge CFStringRef)string);
+	if(characters == NULL) {
+		copiedCharacters = malloc(length * sizeof(uint16_t));
+		if(copiedCharacters == NULL)
+			return nil;
+
+		[string getCharacters:(unichar *)copiedCharacters range:NSMakeRange(0, length)];
+		characters = copiedCharacters;
+	}
+
+	data = [NSMutableData dataWithLength:amd_utf16_utf8_length(characters, length)];
+	amd_utf16_to_utf8(data.mutableBytes, characters, length);
+	free(copiedCharacters);
+
+	return data;
+}
+
+static const char *amd_array_buffer_ascii_pointer(NSString *string)
+{
+	const char *characters;
+	size_t length = string.length;
+
+	characters = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingASCII);
+	if(characters == NULL)
+		return NULL;
+
+	// Embedded NUL characters end the C string early
+	if(strlen(characters) != length
+	   || amd_ascii_length((const uint8_t *)characters, length) != length)
+		return NULL;
+
+	return characters;
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "L8Value+AMDLazyProperties.h"
+
+/**
+ * Replace a lazy property by a plain one.
+ *
+ * @param object The object with the property.
+ * @param property Name of the property.
+ * @param value The value of the property.
+ */
+static void amd_lazy_property_materialize(L8Value *object, NSString *property, L8Value *value);
+
+@implementation L8Value (AMDLazyProperties)
+
+- (void)defineLazyProperty:(NSString *)property withBlock:(id (^)(void))block
+{
+	// The getter is called with the object as this: capturing
+	// self would keep the object alive through its own property.
+	[self defineProperty:property descriptor:@{
+		@"get": ^L8Value *{
+			L8Context *context = [L8Context currentContext];
+			L8Value *value;
+
+			value = [L8Value valueWithObject:block() inContext:context];
+			amd_lazy_property_materialize([L8Context currentThis], property, value);
+
+			return value;
+		},
+		@"set": ^(L8Value *value) {
+			amd_lazy_property_materialize([L8Context currentThis], property, value);
+		},
+		@"enumerable": @YES,
+		@"configurable": @YES
+	}];
+}
+
+@end
+
+static void amd_lazy_property_materialize(L8Value *object, NSString *property, L8Value *value)
+{
+	[object defineProperty:property descriptor:@{
+		@"value": value,
+		@"writable": @YES,
+		@"enumerable": @YES,
+		@"configurable": @YES
+	}];
+}
@@ -24,26 +24,27 @@
  */
 
 #import "NSData+AMDAdditions.h"
+#import "AMDCodec.h"
 
 @implementation NSData (AMDAdditions)
 
 - (NSString *)hexadecimalString
 {
-    const unsigned char *dataBuffer;
-    NSUInteger dataLength;
-	NSMutableString *hexString;
+	char *characters;
 
-	dataBuffer = (const unsigned char *)[self bytes];
-    if(!dataBuffer)
-        return @"";
+	if(self.length == 0)
+		return @"";
 
-    dataLength = [self length];
-    hexString = [NSMutableString stringWithCapacity:(dataLength * 2)];
+	characters = malloc(self.length * 2);
+	if(characters == NULL)
+		return nil;
 
-    for(unsigned int i = 0; i < dataLength; ++i)
-        [hexString appendFormat:@"%02x", (unsigned int)dataBuffer[i]];
+	amd_hex_encode(characters, self.bytes, self.length);
 
-    return [NSString stringWithString:hexString];
+	return [[NSString alloc] initWithBytesNoCopy:characters
+										  length:self.length * 2
+										encoding:NSASCIIStringEncoding
+									freeWhenDone:YES];
 }
 
 @end
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Posted on the main queue when watched files changed.
+ *
+ * The user info has the absolute paths of the changed files, an
+ * NSArray, under AMDFileWatcherPathsKey.
+ */
+extern NSString *const AMDFilesDidChangeNotification;
+
+/// Key of the changed paths in the user info of AMDFilesDidChangeNotification.
+extern NSString *const AMDFileWatcherPathsKey;
+
+/**
+ * @brief Watches directories for changed files.
+ *
+ * Uses FSEvents with file level events. Changes that arrive within
+ * the latency are coalesced into one notification, so saving a file
+ * in an editor that writes it several times reloads it once.
+ *
+ * Used during development, so scripts and assets can be reloaded
+ * without restarting the game.
+ */
+@interface AMDFileWatcher : NSObject
+
+/// The watched directories.
+@property (readonly) NSArray *paths;
+
+/// Seconds to wait for more changes before posting. Defaults to 0.1.
+@property (readonly) NSTimeInterval latency;
+
+/// Whether the watcher is running.
+@property (readonly,getter=isWatching) BOOL watching;
+
+/**
+ * Initialize with directories to watch.
+ *
+ * @param paths Absolute paths of the directories, recursively watched.
+ * @param latency Seconds to wait for more changes before posting.
+ * @return self
+ */
+- (instancetype)initWithPaths:(NSArray *)paths latency:(NSTimeInterval)latency;
+
+/**
+ * Start watching.
+ *
+ * @return YES on success, NO if the event stream can't be created.
+ */
+- (BOOL)start;
+
+/**
+ * Stop watching.
+ */
+- (void)stop;
+
+@end
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDFileWatcher.h"
+
+#include <CoreServices/CoreServices.h>
+
+NSString *const AMDFilesDidChangeNotification = @"AMDFilesDidChangeNotification";
+NSString *const AMDFileWatcherPathsKey = @"paths";
+
+/**
+ * FSEvents callback.
+ */
+static void amd_file_watcher_callback(ConstFSEventStreamRef stream,
+									  void *info,
+									  size_t numEvents,
+									  void *eventPaths,
+									  const FSEventStreamEventFlags eventFlags[],
+									  const FSEventStreamEventId eventIds[]);
+
+@interface AMDFileWatcher ()
+- (void)filesDidChange:(NSArray *)paths;
+@end
+
+@implementation AMDFileWatcher {
+	FSEventStreamRef _stream;
+}
+
+- (instancetype)init
+{
+	return [self initWithPaths:@[] latency:0.1];
+}
+
+- (instancetype)initWithPaths:(NSArray *)paths latency:(NSTimeInterval)latency
+{
+	self = [super init];
+	if(self) {
+		_paths = [paths copy];
+		_latency = latency;
+	}
+	return self;
+}
+
+- (void)dealloc
+{
+	[self stop];
+}
+
+- (BOOL)watching
+{
+	return _stream != NULL;
+}
+
+- (BOOL)start
+{
+	FSEventStreamContext context = {0, (__bridge void *)self, NULL, NULL, NULL};
+
+	if(_stream != NULL)
+		return YES;
+
+	_stream = FSEventStreamCreate(kCFAllocatorDefault,
+								  amd_file_watcher_callback,
+								  &context,
+								  (__bridge CFArrayRef)_paths,
+								  kFSEventStreamEventIdSinceNow,
+								  _latency,
+								  kFSEventStreamCreateFlagUseCFTypes
+								  | kFSEventStreamCreateFlagFileEvents
+								  | kFSEventStreamCreateFlagNoDefer);
+	if(_stream == NULL) {
+		NSLog(@"Failed to watch %@",_paths);
+		return NO;
+	}
+
+	// Changes are handled where the game runs
+	FSEventStreamSetDispatchQueue(_stream, dispatch_get_main_queue());
+	if(!FSEventStreamStart(_stream)) {
+		NSLog(@"Failed to watch %@",_paths);
+		FSEventStreamInvalidate(_stream);
+		FSEventStreamRelease(_stream);
+		_stream = NULL;
+		return NO;
+	}
+
+	return YES;
+}
+
+- (void)stop
+{
+	if(_stream == NULL)
+		return;
+
+	FSEventStreamStop(_stream);
+	FSEventStreamInvalidate(_stream);
+	FSEventStreamRelease(_stream);
+	_stream = NULL;
+}
+
+- (void)filesDidChange:(NSArray *)paths
+{
+	[[NSNotificationCenter defaultCenter] postNotificationName:AMDFilesDidChangeNotification
+														object:self
+													  userInfo:@{AMDFileWatcherPathsKey:paths}];
+}
+
+@end
+
+static void amd_file_watcher_callback(ConstFSEventStreamRef stream,
+									  void *info,
+									  size_t numEvents,
+									  void *eventPaths,
+									  const FSEventStreamEventFlags eventFlags[],
+									  const FSEventStreamEventId eventIds[])
+{
+	AMDFileWatcher *watcher = (__bridge AMDFileWatcher *)info;
+	NSArray *allPaths = (__bridge NSArray *)eventPaths;
+	NSMutableOrderedSet *paths;
+
+	paths = [NSMutableOrderedSet orderedSetWithCapacity:numEvents];
+	for(size_t i = 0; i < numEvents; ++i) {
+		// Only files: directories change with every file in them
+		if(eventFlags[i] & kFSEventStreamEventFlagItemIsDir)
+			continue;
+
+		[paths addObject:[allPaths[i] stringByStandardizingPath]];
+	}
+
+	if(paths.count > 0)
+		[watcher filesDidChange:paths.array];
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @brief Runs a game without a window, graphics or real time.
+ *
+ * The runner boots a JavaScript context the same way the application
+ * does, but does not create an OpenGL view or a display link. Instead
+ * it runs a fixed number of frames as fast as possible on a simulated
+ * clock: Date and Math.random are replaced by deterministic versions,
+ * and every frame the engine sends a 'frame' event and runs all queued
+ * callbacks before the next frame starts. Two runs with the same seed
+ * and frame count do exactly the same. Input recorded in a play
+ * session can be played back, on the simulated clock.
+ *
+ * Used for soak tests and performance regression tests on machines
+ * without a display or GPU.
+ */
+@interface AMDHeadlessRunner : NSObject
+
+/// Number of frames to run. Defaults to 600.
+@property (assign) NSUInteger numberOfFrames;
+
+/// Simulated frames per second. Defaults to 60.
+@property (assign) NSUInteger frameRate;
+
+/// Seed of Math.random. Defaults to 1.
+@property (assign) uint32_t seed;
+
+/// Simulated time at the first frame, in milliseconds since 1970.
+@property (assign) double startTime;
+
+/// Path of an input recording to play back, or nil.
+@property (copy) NSString *replayPath;
+
+/// Path to write a module bundle of the game to instead of running
+/// it, or nil.
+@property (copy) NSString *bundlePath;
+
+/**
+ * Initialize with command line arguments.
+ *
+ * Understands --frames=N, --fps=N, --seed=N, --start-time=MS,
+ * --replay=PATH and --build-bundle=PATH.
+ * Other arguments are ignored.
+ *
+ * @param arguments The command line arguments.
+ * @return self
+ */
+- (instancetype)initWithArguments:(NSArray *)arguments;
+
+/**
+ * Boot the engine and run all frames.
+ *
+ * When bundlePath is set, only boots to build the bundle.
+ *
+ * @return The exit status: 0 on success, 1 if the game failed to boot
+ * or the replay could not be loaded.
+ */
+- (int)run;
+
+/**
+ * Find whether the command line asks for a headless run.
+ *
+ * @param argc Number of arguments.
+ * @param argv The arguments.
+ * @return YES if --headless is one of the arguments.
+ */
++ (BOOL)isHeadlessRunWithArgc:(int)argc argv:(const char **)argv;
+
+@end
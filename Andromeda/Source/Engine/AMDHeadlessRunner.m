@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDHeadlessRunner.h"
+
+#import <L8Framework/L8.h>
+#import "AMDJSClass.h"
+#import "AMDConsole.h"
+#import "AMDEngine.h"
+#import "AMDInput.h"
+#import "AMDInputRecorder.h"
+#import "AMDGamepadManager.h"
+#import "AMDVirtualGamepadBackend.h"
+#import "AMDModuleBundle.h"
+
+/**
+ * Replaces Date and Math.random with versions that only depend on
+ * the seed and the simulated time. Returns a function that moves the
+ * simulated time forward.
+ */
+static NSString *const AMDHeadlessClockScript = @
+"(function (seed, now) {\n"
+"	var RealDate = Date, state = (seed >>> 0) || 1;\n"
+"	function SimulatedDate(a, b, c, d, e, f, g) {\n"
+"		if(!(this instanceof SimulatedDate))\n"
+"			return new RealDate(now).toString();\n"
+"		switch(arguments.length) {\n"
+"		case 0: return new RealDate(now);\n"
+"		case 1: return new RealDate(a);\n"
+"		default: return new RealDate(a, b, c || 1, d || 0, e || 0, f || 0, g || 0);\n"
+"		}\n"
+"	}\n"
+"	SimulatedDate.prototype = RealDate.prototype;\n"
+"	SimulatedDate.parse = RealDate.parse;\n"
+"	SimulatedDate.UTC = RealDate.UTC;\n"
+"	SimulatedDate.now = function () { return now; };\n"
+"	global.Date = SimulatedDate;\n"
+"	Math.random = function () {\n"
+"		state ^= state << 13; state ^= state >>> 17; state ^= state << 5;\n"
+"		return (state >>> 0) / 4294967296;\n"
+"	};\n"
+"	return function (ms) { now += ms; return now; };\n"
+"})";
+
+@implementation AMDHeadlessRunner {
+	L8Context *_javaScriptContext;
+	AMDEngine *_engine;
+	L8Value *_advanceClock;
+	AMDInputRecorder *_recorder;
+}
+
+- (instancetype)init
+{
+	return [self initWithArguments:@[]];
+}
+
+- (instancetype)initWithArguments:(NSArray *)arguments
+{
+	self = [super init];
+	if AMD_LIKELY(self) {
+		_numberOfFrames = 600;
+		_frameRate = 60;
+		_seed = 1;
+		_startTime = 1388534400000.0; // 2014-01-01 00:00:00 UTC
+
+		for(NSString *argument in arguments) {
+			NSArray *parts = [argument componentsSeparatedByString:@"="];
+			NSString *value;
+
+			if(parts.count != 2)
+				continue;
+			value = parts[1];
+
+			if([parts[0] isEqualToString:@"--frames"])
+				_numberOfFrames = MAX(value.integerValue, 0);
+			else if([parts[0] isEqualToString:@"--fps"])
+				_frameRate = MAX(value.integerValue, 1);
+			else if([parts[0] isEqualToString:@"--seed"])
+				_seed = (uint32_t)value.longLongValue;
+			else if([parts[0] isEqualToString:@"--start-time"])
+				_startTime = value.doubleValue;
+			else if([parts[0] isEqualToString:@"--replay"])
+				_replayPath = [value stringByExpandingTildeInPath];
+			else if([parts[0] isEqualToString:@"--build-bundle"])
+				_bundlePath = [value stringByExpandingTildeInPath];
+		}
+	}
+	return self;
+}
+
++ (BOOL)isHeadlessRunWithArgc:(int)argc argv:(const char **)argv
+{
+	for(int i = 1; i < argc; i++) {
+		if(strcmp(argv[i], "--headless") == 0)
+			return YES;
+	}
+	return NO;
+}
+
+#pragma mark - Running
+
+- (BOOL)boot
+{
+	__block BOOL success = NO;
+
+	// Real devices would make the run depend on the machine
+	[AMDGamepadManager setDefaultBackendClass:[AMDVirtualGamepadBackend class]];
+
+	// The module loader builds the bundle instead of running the game
+	[AMDModuleBundle setBuildPath:_bundlePath];
+
+	_javaScriptContext = [[L8Context alloc] init];
+
+	[_javaScriptContext executeBlockInContext:^(L8Context *context) {
+		L8Value *ret;
+		NSString *mainPath;
+
+		_engine = [[AMDEngine alloc] init];
+
+		// Install the globals
+		context[@"console"] = [[AMDConsole alloc] init];
+		context[@"engine"] = _engine;
+		context[@"global"] = context.globalObject;
+		spr_install_js_lib(context);
+
+		[_engine warmUpPreviouslyUsedBindings];
+
+		mainPath = [[NSBundle mainBundle] pathForResource:@"andromeda"
+												   ofType:@"js"];
+
+		@try {
+			ret = [context evaluateScript:AMDHeadlessClockScript
+								 withName:@"headless_clock.js"];
+			_advanceClock = [ret callWithArguments:@[@(_seed), @(_startTime)]];
+
+			ret = [context evaluateScript:[NSString stringWithContentsOfFile:mainPath
+																	encoding:NSUTF8StringEncoding
+																	   error:NULL]
+								 withName:[mainPath lastPathComponent]];
+			if(![ret isFunction])
+				return;
+
+			// Execute Andromeda
+			[ret callWithArguments:@[_engine]];
+			success = YES;
+
+			_recorder = [(AMDInput *)[context[@"Input"] toObjectOfClass:[AMDInput class]] recorder];
+		} @catch(id exc) {
+			fprintf(stderr,"[EXC ] %s\n",[[exc description] UTF8String]);
+		}
+	}];
+
+	return success;
+}
+
+/**
+ * Run everything that was dispatched to the main queue, including
+ * what is dispatched while doing so.
+ */
+- (void)drainMainQueue
+{
+	while(CFRunLoopRunInMode(kCFRunLoopDefaultMode, 0, true) == kCFRunLoopRunHandledSource)
+		;
+}
+
+- (BOOL)loadReplay
+{
+	NSData *recording;
+	NSError *error;
+
+	recording = [NSData dataWithContentsOfFile:_replayPath options:0 error:&error];
+	if(recording == nil) {
+		fprintf(stderr,"[HEAD] Failed to read replay %s: %s\n",
+				_replayPath.UTF8String,error.localizedDescription.UTF8String);
+		return NO;
+	}
+
+	if(_recorder == nil || ![_recorder loadReplay:recording]) {
+		fprintf(stderr,"[HEAD] Invalid replay %s\n",_replayPath.UTF8String);
+		return NO;
+	}
+
+	return YES;
+}
+
+- (int)run
+{
+	double frameTime = 1000.0 / _frameRate;
+	CFAbsoluteTime startWallTime, wallTime;
+
+	if(![self boot])
+		return 1;
+
+	if(_bundlePath != nil)
+		return 0;
+
+	if(_replayPath != nil && ![self loadReplay])
+		return 1;
+
+	// Callbacks queued during boot belong before the first frame
+	[self drainMainQueue];
+
+	startWallTime = CFAbsoluteTimeGetCurrent();
+
+	for(NSUInteger frame = 0; frame < _numberOfFrames; ++frame) {
+		@autoreleasepool {
+			__block double now = 0;
+
+			[_javaScriptContext executeBlockInContext:^(L8Context *context) {
+				@try {
+					now = [[_advanceClock callWithArguments:@[@(frameTime)]] toDouble];
+				} @catch(id exc) {
+					fprintf(stderr,"[EXC ] %s\n",[[exc description] UTF8String]);
+				}
+			}];
+
+			// Input of this frame arrives before the frame
+			[_recorder replayEventsUntilTime:(frame + 1) / (double)_frameRate];
+
+			[_engine triggerEvent:@"frame" withArguments:@[@(frame), @(now)]];
+			[AMDEventEmitter flushEventQueue];
+			[self drainMainQueue];
+		}
+	}
+
+	wallTime = CFAbsoluteTimeGetCurrent() - startWallTime;
+	fprintf(stdout,"[HEAD] %lu frames in %.3f s (%.3f ms/frame)\n",
+			(unsigned long)_numberOfFrames,wallTime,
+			_numberOfFrames ? wallTime * 1000.0 / _numberOfFrames : 0.0);
+
+	return 0;
+}
+
+@end
@@ -27,6 +27,8 @@
 
 #import <FMDB/FMDatabase.h>
 
+AMD_REGISTER_JS_CLASS(AMDSQLiteDatabase, "Database");
+
 @implementation AMDSQLiteDatabase {
 	NSString *_path;
 	NSMutableDictionary *_tables;
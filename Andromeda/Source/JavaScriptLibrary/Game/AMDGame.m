@@ -25,6 +25,8 @@
 
 #import "AMDGame.h"
 
+AMD_REGISTER_JS_CLASS(AMDGame, "Game");
+
 @implementation AMDGame
 
 @synthesize name, author, description;
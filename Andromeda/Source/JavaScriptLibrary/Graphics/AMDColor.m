@@ -25,6 +25,8 @@
 
 #import "AMDColor.h"
 
+AMD_REGISTER_JS_CLASS(AMDColor, "Color");
+
 @implementation AMDColor
 
 @synthesize red=_red, green=_green, blue=_blue, alpha=_alpha;
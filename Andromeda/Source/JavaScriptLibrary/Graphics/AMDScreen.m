@@ -26,6 +26,8 @@
 #import "AMDScreen.h"
 #import "AMDColor.h"
 
+AMD_REGISTER_JS_CLASS(AMDScreen, "Screen");
+
 @implementation AMDScreen
 
 + (void)installIntoContext:(L8Context *)context
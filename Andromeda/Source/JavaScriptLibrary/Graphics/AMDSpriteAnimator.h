@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDJSClass.h"
+
+/**
+ * @brief The sprite animator: JavaScript exports.
+ *
+ * Sprites are plain numbers in JavaScript. All sprites are animated
+ * natively by a single call to tick() per frame.
+ */
+@protocol AMDSpriteAnimator <L8Export>
+
+/**
+ * Create a sprite.
+ *
+ * @param path Path of the sprite set (.rss) file.
+ * @param direction Index of the direction to start with.
+ * @return Handle of the sprite, or 0 on failure.
+ */
+L8_EXPORT_AS(create,
++ (uint32_t)createSpriteWithSpriteSetAtPath:(NSString *)path direction:(uint32_t)direction
+);
+
+/**
+ * Remove a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ */
+L8_EXPORT_AS(remove,
++ (void)removeSprite:(uint32_t)sprite
+);
+
+/**
+ * Change the direction of a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ * @param direction Index of the direction.
+ * @return true on success, false if the sprite or direction does not exist.
+ */
+L8_EXPORT_AS(setDirection,
++ (BOOL)setDirectionOfSprite:(uint32_t)sprite to:(uint32_t)direction
+);
+
+/**
+ * Pause or resume a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ * @param playing true to play, false to pause.
+ */
+L8_EXPORT_AS(setPlaying,
++ (void)setPlayingOfSprite:(uint32_t)sprite to:(BOOL)playing
+);
+
+/**
+ * Get the direction of a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ * @return Index of the direction.
+ */
+L8_EXPORT_AS(getDirection,
++ (uint32_t)directionOfSprite:(uint32_t)sprite
+);
+
+/**
+ * Get the frame of a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ * @return Index of the frame within its direction.
+ */
+L8_EXPORT_AS(getFrame,
++ (uint32_t)frameOfSprite:(uint32_t)sprite
+);
+
+/**
+ * Get the image shown by a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ * @return Index of the image in its sprite set.
+ */
+L8_EXPORT_AS(getImage,
++ (uint32_t)imageOfSprite:(uint32_t)sprite
+);
+
+/**
+ * Advance all sprites.
+ *
+ * @param frames Number of frames to advance. [optional, default 1]
+ * @return Number of sprites that changed image.
+ */
+L8_EXPORT_AS(tick,
++ (uint32_t)advanceByFrames
+);
+
+/**
+ * Get the sprites that changed image in the last tick.
+ *
+ * @return An array of sprite handles.
+ */
+L8_EXPORT_AS(getChanged,
++ (NSArray *)changedSprites
+);
+
+@end
+
+/**
+ * @brief The sprite animator.
+ */
+@interface AMDSpriteAnimator : NSObject <AMDSpriteAnimator, AMDJSClass>
+
+@end
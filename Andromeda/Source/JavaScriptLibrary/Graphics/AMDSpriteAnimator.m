@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <AndromedaKit/AndromedaKit.h>
+#import "AMDSpriteAnimator.h"
+#import "AMDFileWatcher.h"
+
+/// Maximum number of sprites alive at the same time.
+#define AMD_SPRITE_ANIMATOR_CAPACITY 4096
+
+static AMKSpriteAnimator *sharedAnimator;
+static NSMutableDictionary *spriteSets; // Path -> AMKSpriteSet, retained in the resource cache
+
+AMD_REGISTER_JS_CLASS(AMDSpriteAnimator, "SpriteAnimator");
+
+@implementation AMDSpriteAnimator
+
++ (void)installIntoContext:(L8Context *)context
+{
+	static dispatch_once_t onceToken;
+	dispatch_once(&onceToken, ^{
+		sharedAnimator = [[AMKSpriteAnimator alloc] initWithCapacity:AMD_SPRITE_ANIMATOR_CAPACITY];
+		spriteSets = [[NSMutableDictionary alloc] init];
+
+		// New sprites use the changed set, existing ones keep theirs
+		[[NSNotificationCenter defaultCenter] addObserverForName:AMDFilesDidChangeNotification
+														  object:nil
+														   queue:nil
+													  usingBlock:^(NSNotification *notification) {
+			for(NSString *path in notification.userInfo[AMDFileWatcherPathsKey]) {
+				[[AMKResourceCache sharedCache] releaseResource:spriteSets[path]];
+				[spriteSets removeObjectForKey:path];
+			}
+		}];
+	});
+
+	context[@"SpriteAnimator"] = [AMDSpriteAnimator class];
+}
+
++ (uint32_t)createSpriteWithSpriteSetAtPath:(NSString *)path direction:(uint32_t)direction
+{
+	AMKSpriteSet *spriteSet;
+
+	path = [path stringByExpandingTildeInPath];
+	if(![path hasPrefix:@"/"]) {
+		NSString *ext = [path pathExtension];
+		path = [[path lastPathComponent] stringByDeletingPathExtension];
+		path = [[NSBundle mainBundle] pathForResource:path ofType:ext];
+	}
+
+	if(path == nil)
+		return AMK_SPRITE_HANDLE_INVALID;
+
+	// Sprites of the same set share its frame tables
+	spriteSet = spriteSets[path];
+	if(spriteSet == nil) {
+		// Possibly loaded in the background already
+		spriteSet = [[AMKResourceCache sharedCache] retainResourceOfClass:[AMKSpriteSet class]
+																   atPath:path];
+		if(spriteSet == nil)
+			return AMK_SPRITE_HANDLE_INVALID;
+		spriteSets[path] = spriteSet;
+	}
+
+	return [sharedAnimator addSpriteWithSpriteSet:spriteSet direction:direction];
+}
+
++ (void)removeSprite:(uint32_t)sprite
+{
+	[sharedAnimator removeSprite:sprite];
+}
+
++ (BOOL)setDirectionOfSprite:(uint32_t)sprite to:(uint32_t)direction
+{
+	return [sharedAnimator setDirection:direction forSprite:sprite];
+}
+
++ (void)setPlayingOfSprite:(uint32_t)sprite to:(BOOL)playing
+{
+	[sharedAnimator setPlaying:playing forSprite:sprite];
+}
+
++ (uint32_t)directionOfSprite:(uint32_t)sprite
+{
+	return [sharedAnimator directionOfSprite:sprite];
+}
+
++ (uint32_t)frameOfSprite:(uint32_t)sprite
+{
+	return [sharedAnimator frameOfSprite:sprite];
+}
+
++ (uint32_t)imageOfSprite:(uint32_t)sprite
+{
+	return [sharedAnimator imageOfSprite:sprite];
+}
+
++ (uint32_t)advanceByFrames
+{
+	NSArray *args = [L8Context currentArguments];
+	uint32_t frames = 1;
+
+	if(args.count >= 1 && ![args[0] isUndefined])
+		frames = [args[0] toUInt32];
+
+	return (uint32_t)[sharedAnimator advanceByFrames:frames];
+}
+
++ (NSArray *)changedSprites
+{
+	const amk_sprite_handle_t *changed = [sharedAnimator changedSprites];
+	NSUInteger count = sharedAnimator.numberOfChangedSprites;
+	NSMutableArray *sprites;
+
+	sprites = [NSMutableArray arrayWithCapacity:count];
+	for(NSUInteger i = 0; i < count; ++i)
+		[sprites addObject:@(changed[i])];
+
+	return sprites;
+}
+
+@end
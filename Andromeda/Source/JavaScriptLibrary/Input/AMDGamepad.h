@@ -24,6 +24,9 @@
  */
 
 #import "AMDInputDevice.h"
+#import "AMDGamepadBackend.h"
+
+@class AMDGamepadManager;
 
 /// Gamepad axes.
 typedef enum spr_gamepad_axis_e : unsigned int {
@@ -36,6 +39,9 @@ typedef enum spr_gamepad_axis_e : unsigned int {
  */
 @protocol AMDGamepad <L8Export>
 
+/// Whether the gamepad is connected.
+@property (readonly) BOOL connected;
+
 /// Get the number of buttons.
 @property (readonly) size_t numberOfButtons;
 
@@ -58,11 +64,53 @@ typedef enum spr_gamepad_axis_e : unsigned int {
  */
 - (double)getAxis:(spr_gamepad_axis_t)axis;
 
+/**
+ * Get the next pressed button from the queue.
+ *
+ * @return A button, or NONE when the queue is empty.
+ */
+- (int)getButton;
+
+/**
+ * Empty the queue. For example, when new user input will start.
+ */
+- (void)clearQueue;
+
 @end
 
 /**
  * @brief Gamepad input device.
+ *
+ * Reads the latest snapshot of its AMDGamepadManager, so none of the
+ * methods wait for the device.
  */
 @interface AMDGamepad : AMDInputDevice <AMDGamepad>
 
+/// Index of the gamepad in its manager.
+@property (readonly) NSUInteger index;
+
+/// Latest state of the gamepad.
+@property (readonly) amd_gamepad_state_t state;
+
+/**
+ * Initialize a gamepad of a manager.
+ *
+ * @param manager The manager. Not retained.
+ * @param index Index of the gamepad.
+ * @return self
+ */
+- (instancetype)initWithManager:(AMDGamepadManager *)manager index:(NSUInteger)index;
+
+/**
+ * Add a button press or release to the queue.
+ *
+ * Called by the AMDGamepadManager, on its polling thread or for a
+ * replayed state.
+ *
+ * @param button The button.
+ * @param pressed YES when pressed, NO when released.
+ * @param timestamp Time of the event, in seconds since system startup.
+ */
+- (void)queueButton:(int)button pressed:(BOOL)pressed timestamp:(double)timestamp;
+
 @end
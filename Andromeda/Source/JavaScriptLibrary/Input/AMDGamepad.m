@@ -24,8 +24,11 @@
  */
 
 #import "AMDGamepad.h"
+#import "AMDGamepadManager.h"
 
-@implementation AMDGamepad
+@implementation AMDGamepad {
+	__weak AMDGamepadManager *_manager;
+}
 
 + (void)installIntoContext:(L8Context *)context
 {
@@ -46,24 +49,98 @@
 	context[@"Input"][@"Gamepad"] = gamepad;
 }
 
+- (instancetype)initWithManager:(AMDGamepadManager *)manager index:(NSUInteger)index
+{
+	self = [super init];
+	if(self) {
+		_manager = manager;
+		_index = index;
+	}
+	return self;
+}
+
+- (amd_gamepad_state_t)state
+{
+	amd_gamepad_state_t state;
+
+	[_manager getState:&state ofGamepad:_index];
+
+	return state;
+}
+
+- (BOOL)connected
+{
+	return self.state.connected;
+}
+
 - (size_t)numberOfButtons
 {
-	return 0;
+	return self.state.numberOfButtons;
 }
 
 - (size_t)numberOfAxes
 {
-	return 0;
+	return self.state.numberOfAxes;
 }
 
 - (BOOL)isButtonPressed:(int)button
 {
-	return NO;
+	if(button <= 0 || button > AMD_GAMEPAD_MAX_BUTTONS)
+		return NO;
+
+	return (self.state.buttons >> (button - 1)) & 1;
 }
 
 - (double)getAxis:(spr_gamepad_axis_t)axis
 {
-	return 0.0;
+	if((unsigned int)axis >= AMD_GAMEPAD_MAX_AXES)
+		return 0.0;
+
+	return self.state.axes[axis];
+}
+
+- (int)getButton
+{
+	amd_input_event_t input;
+
+	// Releases are queued for the driver, but not reported
+	while(amd_input_queue_pop(self.queue, &input)) {
+		if(input.flags & AMD_INPUT_EVENT_PRESSED)
+			return input.code;
+	}
+
+	return 0;
+}
+
+- (void)clearQueue
+{
+	amd_input_queue_clear(self.queue);
+}
+
+- (void)queueButton:(int)button pressed:(BOOL)pressed timestamp:(double)timestamp
+{
+	amd_input_event_t input;
+
+	input.timestamp = timestamp;
+	input.x = 0;
+	input.y = 0;
+	input.code = (uint16_t)button;
+	input.modifiers = 0;
+	input.flags = pressed ? AMD_INPUT_EVENT_PRESSED : 0;
+
+	[self handleInputEvent:&input];
+}
+
+- (amd_input_device_t)deviceType
+{
+	return AMD_INPUT_DEVICE_GAMEPAD;
+}
+
+- (void)handleInputEvent:(const amd_input_event_t *)event
+{
+	[super handleInputEvent:event];
+
+	amd_input_queue_push(self.queue, event);
 }
 
 @end
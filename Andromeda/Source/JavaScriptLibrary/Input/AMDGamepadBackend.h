@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/// Maximum number of gamepads.
+#define AMD_GAMEPAD_MAX_DEVICES		4
+
+/// Maximum number of buttons of a gamepad.
+#define AMD_GAMEPAD_MAX_BUTTONS		32
+
+/// Maximum number of axes of a gamepad.
+#define AMD_GAMEPAD_MAX_AXES		8
+
+/// State of a gamepad at one moment.
+typedef struct amd_gamepad_state_s {
+	/// Bit n is set when button n + 1 is pressed.
+	uint32_t buttons;
+	/// Axis positions, from -1.0 to 1.0.
+	float axes[AMD_GAMEPAD_MAX_AXES];
+	uint8_t numberOfButtons;
+	uint8_t numberOfAxes;
+	/// Whether the gamepad is connected.
+	bool connected;
+} amd_gamepad_state_t;
+
+/**
+ * @brief A source of gamepad states.
+ *
+ * All methods are called on the polling thread of the
+ * AMDGamepadManager, so they may block on device I/O.
+ */
+@protocol AMDGamepadBackend <NSObject>
+
+/**
+ * Start using the devices.
+ *
+ * @return YES on success, NO on failure.
+ */
+- (BOOL)open;
+
+/**
+ * Stop using the devices.
+ */
+- (void)close;
+
+/**
+ * Read the current state of all gamepads.
+ *
+ * @param states Array to fill. Initially all zero.
+ * @param count Length of the array.
+ * @return The number of gamepads found.
+ */
+- (NSUInteger)pollStates:(amd_gamepad_state_t *)states count:(NSUInteger)count;
+
+@end
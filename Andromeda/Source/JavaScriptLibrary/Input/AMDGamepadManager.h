@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDGamepadBackend.h"
+
+@class AMDGamepad, AMDInputRecorder;
+
+/**
+ * @brief Polls gamepads on a thread of its own.
+ *
+ * The backend is polled at a fixed rate. After every poll, the states
+ * of all gamepads are published as a snapshot that can be read from
+ * any thread without locking, so the script never waits on device
+ * I/O. Button changes are also queued on the gamepads.
+ */
+@interface AMDGamepadManager : NSObject
+
+/// The backend.
+@property (readonly) id<AMDGamepadBackend> backend;
+
+/// Polls per second. Defaults to 120.
+@property (assign) NSUInteger pollRate;
+
+/// All gamepads, connected or not. AMD_GAMEPAD_MAX_DEVICES long.
+@property (readonly) NSArray *gamepads;
+
+/// Connected gamepads.
+@property (readonly) NSArray *connectedGamepads;
+
+/// Recorder that receives the states of every poll. Not retained.
+@property (weak) AMDInputRecorder *recorder;
+
+/**
+ * Whether replayed states are published instead of those of the
+ * backend. Starting a replay disconnects all gamepads until the
+ * replay says otherwise.
+ */
+@property (nonatomic) BOOL replaying;
+
+/**
+ * Initialize with a backend.
+ *
+ * @param backend The backend.
+ * @return self
+ */
+- (instancetype)initWithBackend:(id<AMDGamepadBackend>)backend;
+
+/**
+ * Start polling.
+ */
+- (void)start;
+
+/**
+ * Stop polling. Waits for the polling thread to close the backend.
+ */
+- (void)stop;
+
+/**
+ * Get the latest state of a gamepad.
+ *
+ * Never blocks.
+ *
+ * @param state Set to the state.
+ * @param index Index of the gamepad.
+ */
+- (void)getState:(amd_gamepad_state_t *)state ofGamepad:(NSUInteger)index;
+
+/**
+ * Publish a replayed state of a gamepad, as if the backend had
+ * returned it, and queue its button changes.
+ *
+ * Ignored unless replaying.
+ *
+ * @param state The state.
+ * @param index Index of the gamepad.
+ * @param timestamp Time of the state, for the queued buttons.
+ */
+- (void)replayState:(const amd_gamepad_state_t *)state
+		  ofGamepad:(NSUInteger)index
+		  timestamp:(double)timestamp;
+
+/**
+ * Set the class of the backend used by AMDInput.
+ *
+ * Defaults to AMDHIDGamepadBackend.
+ *
+ * @param backendClass A class conforming to AMDGamepadBackend.
+ */
++ (void)setDefaultBackendClass:(Class)backendClass;
+
+/**
+ * Get the class of the backend used by AMDInput.
+ *
+ * @return A class conforming to AMDGamepadBackend.
+ */
++ (Class)defaultBackendClass;
+
+@end
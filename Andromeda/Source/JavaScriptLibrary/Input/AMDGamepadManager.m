@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdatomic.h>
+
+#import "AMDGamepadManager.h"
+#import "AMDGamepad.h"
+#import "AMDHIDGamepadBackend.h"
+#import "AMDInputRecorder.h"
+
+/// Backend class used by AMDInput.
+static Class amd_gamepad_default_backend_class;
+
+@implementation AMDGamepadManager {
+	NSThread *_thread;
+	dispatch_semaphore_t _stopped;
+
+	// Published states, guarded by a sequence lock: the sequence is
+	// odd while written. Writers also hold @synchronized(self), as
+	// both the poller and a replay write.
+	_Atomic uint32_t _sequence;
+	amd_gamepad_state_t _states[AMD_GAMEPAD_MAX_DEVICES];
+}
+
++ (void)setDefaultBackendClass:(Class)backendClass
+{
+	amd_gamepad_default_backend_class = backendClass;
+}
+
++ (Class)defaultBackendClass
+{
+	if(amd_gamepad_default_backend_class == Nil)
+		return [AMDHIDGamepadBackend class];
+	return amd_gamepad_default_backend_class;
+}
+
+- (instancetype)init
+{
+	return [self initWithBackend:[[[[self class] defaultBackendClass] alloc] init]];
+}
+
+- (instancetype)initWithBackend:(id<AMDGamepadBackend>)backend
+{
+	self = [super init];
+	if(self) {
+		NSMutableArray *gamepads;
+
+		_backend = backend;
+		_pollRate = 120;
+		atomic_init(&_sequence, 0);
+
+		gamepads = [NSMutableArray arrayWithCapacity:AMD_GAMEPAD_MAX_DEVICES];
+		for(NSUInteger i = 0; i < AMD_GAMEPAD_MAX_DEVICES; ++i)
+			[gamepads addObject:[[AMDGamepad alloc] initWithManager:self index:i]];
+		_gamepads = [gamepads copy];
+	}
+	return self;
+}
+
+#pragma mark - Polling
+
+- (void)start
+{
+	if(_thread != nil)
+		return;
+
+	_stopped = dispatch_semaphore_create(0);
+	_thread = [[NSThread alloc] initWithTarget:self selector:@selector(pollLoop:) object:nil];
+	_thread.name = @"Gamepad polling";
+	[_thread start];
+}
+
+- (void)stop
+{
+	if(_thread == nil)
+		return;
+
+	[_thread cancel];
+	dispatch_semaphore_wait(_stopped, DISPATCH_TIME_FOREVER);
+	_thread = nil;
+}
+
+- (void)pollLoop:(id)argument
+{
+	amd_gamepad_state_t current[AMD_GAMEPAD_MAX_DEVICES];
+	NSThread *thread = [NSThread currentThread];
+
+	if(![_backend open]) {
+		dispatch_semaphore_signal(_stopped);
+		return;
+	}
+
+	while(!thread.isCancelled) {
+		@autoreleasepool {
+			double timestamp = [[NSProcessInfo processInfo] systemUptime];
+
+			bzero(current, sizeof(current));
+			[_backend pollStates:current count:AMD_GAMEPAD_MAX_DEVICES];
+
+			@synchronized(self) {
+				if(!_replaying) {
+					[self updateStates:current timestamp:timestamp];
+					[_recorder recordGamepadStates:current
+											 count:AMD_GAMEPAD_MAX_DEVICES
+										 timestamp:timestamp];
+				}
+			}
+		}
+
+		[NSThread sleepForTimeInterval:1.0 / MAX(_pollRate, 1)];
+	}
+
+	[_backend close];
+	dispatch_semaphore_signal(_stopped);
+}
+
+#pragma mark - Replaying
+
+- (void)setReplaying:(BOOL)replaying
+{
+	amd_gamepad_state_t none[AMD_GAMEPAD_MAX_DEVICES];
+
+	@synchronized(self) {
+		if(replaying == _replaying)
+			return;
+		_replaying = replaying;
+
+		bzero(none, sizeof(none));
+		[self updateStates:none timestamp:[[NSProcessInfo processInfo] systemUptime]];
+	}
+}
+
+- (void)replayState:(const amd_gamepad_state_t *)state
+		  ofGamepad:(NSUInteger)index
+		  timestamp:(double)timestamp
+{
+	amd_gamepad_state_t states[AMD_GAMEPAD_MAX_DEVICES];
+
+	if AMD_UNLIKELY(index >= AMD_GAMEPAD_MAX_DEVICES)
+		return;
+
+	@synchronized(self) {
+		if(!_replaying)
+			return;
+
+		memcpy(states, _states, sizeof(states));
+		states[index] = *state;
+		[self updateStates:states timestamp:timestamp];
+	}
+}
+
+#pragma mark - Publishing
+
+/**
+ * Publish new states and queue the button changes. The caller holds
+ * @synchronized(self).
+ */
+- (void)updateStates:(const amd_gamepad_state_t *)states timestamp:(double)timestamp
+{
+	amd_gamepad_state_t previous[AMD_GAMEPAD_MAX_DEVICES];
+
+	memcpy(previous, _states, sizeof(previous));
+
+	[self publishStates:states];
+	[self queueChangesFrom:previous to:states timestamp:timestamp];
+}
+
+- (void)publishStates:(const amd_gamepad_state_t *)states
+{
+	uint32_t sequence = atomic_load_explicit(&_sequence, memory_order_relaxed);
+
+	atomic_store_explicit(&_sequence, sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	memcpy(_states, states, sizeof(_states));
+
+	atomic_store_explicit(&_sequence, sequence + 2, memory_order_release);
+}
+
+- (void)queueChangesFrom:(const amd_gamepad_state_t *)previous
+					  to:(const amd_gamepad_state_t *)current
+			   timestamp:(double)timestamp
+{
+	for(NSUInteger i = 0; i < AMD_GAMEPAD_MAX_DEVICES; ++i) {
+		uint32_t changed = previous[i].buttons ^ current[i].buttons;
+
+		while(changed) {
+			int bit = __builtin_ctz(changed);
+
+			[_gamepads[i] queueButton:bit + 1
+							  pressed:(current[i].buttons >> bit) & 1
+							timestamp:timestamp];
+			changed &= changed - 1;
+		}
+	}
+}
+
+#pragma mark - Reading
+
+- (void)getState:(amd_gamepad_state_t *)state ofGamepad:(NSUInteger)index
+{
+	uint32_t before, after;
+
+	if AMD_UNLIKELY(index >= AMD_GAMEPAD_MAX_DEVICES) {
+		bzero(state, sizeof(amd_gamepad_state_t));
+		return;
+	}
+
+	// Retry when the poller wrote while copying. It writes a few
+	// hundred bytes at most, so this does not wait on the device.
+	do {
+		before = atomic_load_explicit(&_sequence, memory_order_acquire);
+		memcpy(state, &_states[index], sizeof(amd_gamepad_state_t));
+		atomic_thread_fence(memory_order_acquire);
+		after = atomic_load_explicit(&_sequence, memory_order_relaxed);
+	} while((before & 1) || before != after);
+}
+
+- (NSArray *)connectedGamepads
+{
+	NSMutableArray *connected = [NSMutableArray array];
+
+	for(AMDGamepad *gamepad in _gamepads) {
+		if(gamepad.connected)
+			[connected addObject:gamepad];
+	}
+
+	return connected;
+}
+
+@end
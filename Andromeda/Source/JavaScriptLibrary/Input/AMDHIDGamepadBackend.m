@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import <IOKit/hid/IOHIDLib.h>
+
+#import "AMDHIDGamepadBackend.h"
+
+/**
+ * @brief The elements of a device that make up the gamepad state.
+ */
+@interface AMDHIDGamepadElements : NSObject
+@property (strong) NSArray *buttons;
+@property (strong) NSArray *axes;
+@end
+
+@implementation AMDHIDGamepadElements
+@end
+
+/**
+ * Find the buttons and axes of a device.
+ *
+ * @param device The device.
+ * @return The elements.
+ */
+static AMDHIDGamepadElements *amd_hid_copy_elements(IOHIDDeviceRef device);
+
+/**
+ * Create a table from devices to their elements.
+ *
+ * IOHIDDevice does not implement NSCopying, so devices cannot be
+ * dictionary keys. The table retains them and compares by pointer.
+ *
+ * @param capacity Initial capacity.
+ * @return The table.
+ */
+static NSMapTable *amd_hid_create_element_table(NSUInteger capacity);
+
+/**
+ * Read the state of a device.
+ *
+ * @param device The device.
+ * @param elements The elements of the device.
+ * @param state Set to the state.
+ */
+static void amd_hid_read_state(IOHIDDeviceRef device,
+							   AMDHIDGamepadElements *elements,
+							   amd_gamepad_state_t *state);
+
+@implementation AMDHIDGamepadBackend {
+	IOHIDManagerRef _manager;
+	NSMapTable *_elements; // IOHIDDeviceRef -> AMDHIDGamepadElements
+}
+
+- (void)dealloc
+{
+	[self close];
+}
+
+- (BOOL)open
+{
+	NSArray *matching;
+	IOReturn ret;
+
+	if(_manager != NULL)
+		return YES;
+
+	_manager = IOHIDManagerCreate(kCFAllocatorDefault, kIOHIDOptionsTypeNone);
+	if AMD_UNLIKELY(_manager == NULL)
+		return NO;
+
+	matching = @[
+		@{ @kIOHIDDeviceUsagePageKey: @(kHIDPage_GenericDesktop),
+		   @kIOHIDDeviceUsageKey: @(kHIDUsage_GD_GamePad) },
+		@{ @kIOHIDDeviceUsagePageKey: @(kHIDPage_GenericDesktop),
+		   @kIOHIDDeviceUsageKey: @(kHIDUsage_GD_Joystick) },
+		@{ @kIOHIDDeviceUsagePageKey: @(kHIDPage_GenericDesktop),
+		   @kIOHIDDeviceUsageKey: @(kHIDUsage_GD_MultiAxisController) }
+	];
+	IOHIDManagerSetDeviceMatchingMultiple(_manager, (__bridge CFArrayRef)matching);
+
+	// Scheduled on the polling thread, which runs the loop every poll
+	IOHIDManagerScheduleWithRunLoop(_manager, CFRunLoopGetCurrent(), kCFRunLoopDefaultMode);
+
+	ret = IOHIDManagerOpen(_manager, kIOHIDOptionsTypeNone);
+	if(ret != kIOReturnSuccess) {
+		NSLog(@"Failed to open HID manager: 0x%08x",ret);
+		[self close];
+		return NO;
+	}
+
+	_elements = amd_hid_create_element_table(0);
+
+	return YES;
+}
+
+- (void)close
+{
+	if(_manager == NULL)
+		return;
+
+	IOHIDManagerUnscheduleFromRunLoop(_manager, CFRunLoopGetCurrent(), kCFRunLoopDefaultMode);
+	IOHIDManagerClose(_manager, kIOHIDOptionsTypeNone);
+	CFRelease(_manager);
+	_manager = NULL;
+
+	_elements = nil;
+}
+
+- (NSUInteger)pollStates:(amd_gamepad_state_t *)states count:(NSUInteger)count
+{
+	NSArray *devices;
+	NSMapTable *elements;
+	NSUInteger found = 0;
+
+	if AMD_UNLIKELY(_manager == NULL)
+		return 0;
+
+	// Let the manager handle devices coming and going
+	CFRunLoopRunInMode(kCFRunLoopDefaultMode, 0, true);
+
+	devices = [(__bridge_transfer NSSet *)IOHIDManagerCopyDevices(_manager) allObjects];
+	devices = [devices sortedArrayUsingComparator:^NSComparisonResult(id a, id b) {
+		NSNumber *la, *lb;
+
+		la = (__bridge NSNumber *)IOHIDDeviceGetProperty((__bridge IOHIDDeviceRef)a,
+														  CFSTR(kIOHIDLocationIDKey));
+		lb = (__bridge NSNumber *)IOHIDDeviceGetProperty((__bridge IOHIDDeviceRef)b,
+														  CFSTR(kIOHIDLocationIDKey));
+		return [la compare:lb];
+	}];
+
+	// Only keep the elements of connected devices
+	elements = amd_hid_create_element_table(devices.count);
+
+	for(id device in devices) {
+		AMDHIDGamepadElements *deviceElements;
+
+		if(found == count)
+			break;
+
+		deviceElements = [_elements objectForKey:device];
+		if(deviceElements == nil)
+			deviceElements = amd_hid_copy_elements((__bridge IOHIDDeviceRef)device);
+		[elements setObject:deviceElements forKey:device];
+
+		amd_hid_read_state((__bridge IOHIDDeviceRef)device, deviceElements, &states[found++]);
+	}
+
+	_elements = elements;
+
+	return found;
+}
+
+@end
+
+static NSMapTable *amd_hid_create_element_table(NSUInteger capacity)
+{
+	return [[NSMapTable alloc] initWithKeyOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality
+									 valueOptions:NSPointerFunctionsStrongMemory
+										 capacity:capacity];
+}
+
+static AMDHIDGamepadElements *amd_hid_copy_elements(IOHIDDeviceRef device)
+{
+	AMDHIDGamepadElements *result;
+	NSArray *elements;
+	NSMutableArray *buttons, *axes;
+
+	result = [[AMDHIDGamepadElements alloc] init];
+	buttons = [NSMutableArray array];
+	axes = [NSMutableArray array];
+
+	elements = (__bridge_transfer NSArray *)IOHIDDeviceCopyMatchingElements(device, NULL,
+																			 kIOHIDOptionsTypeNone);
+	for(id object in elements) {
+		IOHIDElementRef element = (__bridge IOHIDElementRef)object;
+		IOHIDElementType type = IOHIDElementGetType(element);
+		uint32_t page = IOHIDElementGetUsagePage(element);
+		uint32_t usage = IOHIDElementGetUsage(element);
+
+		if(type == kIOHIDElementTypeInput_Button && page == kHIDPage_Button) {
+			if(buttons.count < AMD_GAMEPAD_MAX_BUTTONS)
+				[buttons addObject:object];
+		} else if((type == kIOHIDElementTypeInput_Misc || type == kIOHIDElementTypeInput_Axis)
+				  && page == kHIDPage_GenericDesktop
+				  && usage >= kHIDUsage_GD_X && usage <= kHIDUsage_GD_Wheel) {
+			if(axes.count < AMD_GAMEPAD_MAX_AXES)
+				[axes addObject:object];
+		}
+	}
+
+	// Button 1 is usage 1, and X comes before Y
+	NSComparator byUsage = ^NSComparisonResult(id a, id b) {
+		uint32_t ua = IOHIDElementGetUsage((__bridge IOHIDElementRef)a);
+		uint32_t ub = IOHIDElementGetUsage((__bridge IOHIDElementRef)b);
+
+		return (ua < ub) ? NSOrderedAscending : (ua > ub) ? NSOrderedDescending : NSOrderedSame;
+	};
+	result.buttons = [buttons sortedArrayUsingComparator:byUsage];
+	result.axes = [axes sortedArrayUsingComparator:byUsage];
+
+	return result;
+}
+
+static void amd_hid_read_state(IOHIDDeviceRef device,
+							   AMDHIDGamepadElements *elements,
+							   amd_gamepad_state_t *state)
+{
+	NSUInteger index = 0;
+
+	state->connected = true;
+	state->numberOfButtons = elements.buttons.count;
+	state->numberOfAxes = elements.axes.count;
+
+	for(id object in elements.buttons) {
+		IOHIDValueRef value;
+
+		if(IOHIDDeviceGetValue(device, (__bridge IOHIDElementRef)object, &value) == kIOReturnSuccess
+		   && IOHIDValueGetIntegerValue(value) != 0)
+			state->buttons |= (1u << index);
+		index++;
+	}
+
+	index = 0;
+	for(id object in elements.axes) {
+		IOHIDElementRef element = (__bridge IOHIDElementRef)object;
+		CFIndex min, max;
+		IOHIDValueRef value;
+
+		min = IOHIDElementGetLogicalMin(element);
+		max = IOHIDElementGetLogicalMax(element);
+
+		if(max > min
+		   && IOHIDDeviceGetValue(device, element, &value) == kIOReturnSuccess) {
+			double position = (double)(IOHIDValueGetIntegerValue(value) - min) / (max - min);
+			state->axes[index] = (float)(position * 2.0 - 1.0);
+		}
+		index++;
+	}
+}
@@ -25,7 +25,7 @@
 
 #import "AMDJSClass.h"
 
-@class AMDInput, AMDMouse, AMDKeyboard, AMDGamepad;
+@class AMDInput, AMDMouse, AMDKeyboard, AMDGamepad, AMDInputRecorder, AMDGamepadManager;
 @protocol AMDGamepad;
 
 /**
@@ -33,8 +33,30 @@
  */
 @protocol AMDInput <L8Export>
 
+/// Connected gamepads.
 @property (readonly) NSArray<AMDGamepad> *gamepads;
 
+/// Whether input is being recorded.
+@property (readonly,getter=isRecording) BOOL recording;
+
+/**
+ * Start recording all input. Discards any unsaved recording.
+ */
+- (void)startRecording;
+
+/**
+ * Stop recording input and save the recording.
+ *
+ * The recording can be played back with a headless run
+ * using --replay=path.
+ *
+ * @param path Path of the file to save the recording to.
+ * @return YES on success, NO on failure.
+ */
+L8_EXPORT_AS(stopRecording,
+- (BOOL)stopRecordingToFile:(NSString *)path
+);
+
 @end
 
 /**
@@ -55,6 +77,12 @@
 /// Keyboard input.
 @property (readonly) AMDKeyboard *keyboard;
 
+/// Poller of the gamepads.
+@property (readonly) AMDGamepadManager *gamepadManager;
+
+/// Recorder of the input of all devices.
+@property (readonly) AMDInputRecorder *recorder;
+
 @end
 
 /**
@@ -27,10 +27,12 @@
 #import "AMDKeyboard.h"
 #import "AMDGamepad.h"
 #import "AMDMouse.h"
+#import "AMDInputRecorder.h"
+#import "AMDGamepadManager.h"
 
-@implementation AMDInput
+AMD_REGISTER_JS_CLASS(AMDInput, "Input");
 
-@synthesize gamepads=_gamepads;
+@implementation AMDInput
 
 + (void)installIntoContext:(L8Context *)context
 {
@@ -51,12 +53,57 @@
     if (self) {
 		_mouse = [[AMDMouse alloc] init];
 		_keyboard = [[AMDKeyboard alloc] init];
+		_gamepadManager = [[AMDGamepadManager alloc] init];
+
+		_recorder = [[AMDInputRecorder alloc] init];
+		for(AMDInputDevice *device in @[_mouse, _mouse.wheel, _keyboard]) {
+			device.recorder = _recorder;
+			[_recorder addDevice:device];
+		}
 
-		_gamepads = (NSArray<AMDGamepad> *)@[];
+		// Gamepads are recorded and replayed by state, through the manager
+		_gamepadManager.recorder = _recorder;
+		_recorder.gamepadManager = _gamepadManager;
+
+		[_gamepadManager start];
     }
     return self;
 }
 
+- (NSArray<AMDGamepad> *)gamepads
+{
+	return (NSArray<AMDGamepad> *)_gamepadManager.connectedGamepads;
+}
+
+- (BOOL)isRecording
+{
+	return _recorder.recording;
+}
+
+- (void)startRecording
+{
+	[_recorder startRecording];
+}
+
+- (BOOL)stopRecordingToFile:(NSString *)path
+{
+	NSData *recording;
+	NSError *error;
+
+	recording = [_recorder stopRecording];
+	if(recording == nil)
+		return NO;
+
+	if(![recording writeToFile:[path stringByExpandingTildeInPath]
+					   options:NSDataWritingAtomic
+						 error:&error]) {
+		NSLog(@"Failed to save input recording %@: %@",path,error);
+		return NO;
+	}
+
+	return YES;
+}
+
 @end
 
 @implementation AMDInputConfig
@@ -26,12 +26,36 @@
 #import <L8Framework/L8.h>
 
 #import "AMDEventEmitter.h"
+#import "AMDInputQueue.h"
+
+@class AMDInputRecorder;
+
+/// Kinds of input devices.
+typedef enum amd_input_device_e : uint8_t {
+	AMD_INPUT_DEVICE_NONE		= 0,
+	AMD_INPUT_DEVICE_KEYBOARD	= 1,
+	AMD_INPUT_DEVICE_MOUSE		= 2,
+	AMD_INPUT_DEVICE_MOUSE_WHEEL	= 3,
+	AMD_INPUT_DEVICE_GAMEPAD	= 4
+} amd_input_device_t;
 
 /**
  * @brief Any input device.
  */
 @interface AMDInputDevice : AMDEventEmitter
 
+/// Queue of events of the device, not yet read by the script.
+@property (readonly) amd_input_queue_t *queue NS_RETURNS_INNER_POINTER;
+
+/// Number of events dropped because the queue was full.
+@property (readonly) NSUInteger numberOfDroppedEvents;
+
+/// The kind of device.
+@property (readonly) amd_input_device_t deviceType;
+
+/// Recorder that receives all handled events.
+@property (weak) AMDInputRecorder *recorder;
+
 /**
  * Install the receiving instance in the context.
  *
@@ -43,4 +67,15 @@
  */
 - (void)installInstanceIntoContext:(L8Context *)context AMD_REQUIRES_SUPER;
 
+/**
+ * Handle an input event of the device.
+ *
+ * Both events from the system and replayed events go through this
+ * method. Subclasses update their state, queue the event and trigger
+ * JavaScript events.
+ *
+ * @param event The event.
+ */
+- (void)handleInputEvent:(const amd_input_event_t *)event AMD_REQUIRES_SUPER;
+
 @end
@@ -24,12 +24,50 @@
  */
 
 #import "AMDInputDevice.h"
+#import "AMDInputRecorder.h"
+
+/// Number of events a device queue can hold.
+#define AMD_INPUT_QUEUE_CAPACITY 256
 
 @implementation AMDInputDevice
 
+- (instancetype)init
+{
+	self = [super init];
+	if(self) {
+		_queue = amd_input_queue_create(AMD_INPUT_QUEUE_CAPACITY);
+		if AMD_UNLIKELY(_queue == NULL)
+			return nil;
+	}
+	return self;
+}
+
+- (void)dealloc
+{
+	amd_input_queue_destroy(_queue);
+}
+
 - (void)installInstanceIntoContext:(L8Context *)context
 {
 	
 }
 
+- (NSUInteger)numberOfDroppedEvents
+{
+	return atomic_load_explicit(&_queue->overflows, memory_order_relaxed);
+}
+
+- (amd_input_device_t)deviceType
+{
+	return AMD_INPUT_DEVICE_NONE;
+}
+
+- (void)handleInputEvent:(const amd_input_event_t *)event
+{
+	AMDInputRecorder *recorder = _recorder;
+
+	if(recorder.recording)
+		[recorder recordEvent:event device:self.deviceType];
+}
+
 @end
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/// The event is a key or button press, not a release.
+#define AMD_INPUT_EVENT_PRESSED		(1 << 0)
+
+/// The event is a key repeat.
+#define AMD_INPUT_EVENT_REPEAT		(1 << 1)
+
+/// An input event.
+typedef struct amd_input_event_s {
+	/// Timestamp of the event, in seconds since system startup.
+	double timestamp;
+	/// Horizontal value, such as a scroll delta or axis position.
+	float x;
+	/// Vertical value, such as a scroll delta or axis position.
+	float y;
+	/// Key, button or wheel event, depending on the device.
+	uint16_t code;
+	/// Modifier keys held during the event.
+	uint16_t modifiers;
+	/// AMD_INPUT_EVENT_* flags.
+	uint8_t flags;
+} amd_input_event_t;
+
+/**
+ * @brief A fixed-capacity queue of input events.
+ *
+ * Safe for one producer (the event monitor) and one consumer
+ * (the script) without locking. When the queue is full, new
+ * events are dropped and counted.
+ */
+typedef struct amd_input_queue_s {
+	/// Next event to read. Only written by the consumer.
+	_Atomic size_t head;
+	/// Next slot to write. Only written by the producer.
+	_Atomic size_t tail;
+	/// Number of events dropped because the queue was full.
+	_Atomic size_t overflows;
+	/// Capacity - 1. The capacity is a power of two.
+	size_t mask;
+	amd_input_event_t *events;
+} amd_input_queue_t;
+
+/**
+ * Create an input queue.
+ *
+ * @param capacity Minimum number of events. Rounded up to a power of two.
+ * @return A new queue, or NULL on failure.
+ */
+amd_input_queue_t *amd_input_queue_create(size_t capacity);
+
+/**
+ * Destroy an input queue.
+ *
+ * @param queue The queue.
+ */
+void amd_input_queue_destroy(amd_input_queue_t *queue);
+
+/**
+ * Add an event to the queue. Producer only.
+ *
+ * @param queue The queue.
+ * @param event The event.
+ * @return true on success, false when the queue was full.
+ */
+bool amd_input_queue_push(amd_input_queue_t *queue, const amd_input_event_t *event);
+
+/**
+ * Take the oldest event from the queue. Consumer only.
+ *
+ * @param queue The queue.
+ * @param event Set to the event.
+ * @return true on success, false when the queue was empty.
+ */
+bool amd_input_queue_pop(amd_input_queue_t *queue, amd_input_event_t *event);
+
+/**
+ * Remove all events from the queue. Consumer only.
+ *
+ * @param queue The queue.
+ */
+void amd_input_queue_clear(amd_input_queue_t *queue);
+
+/**
+ * Get the number of events in the queue.
+ *
+ * @param queue The queue.
+ * @return The number of events.
+ */
+size_t amd_input_queue_count(amd_input_queue_t *queue);
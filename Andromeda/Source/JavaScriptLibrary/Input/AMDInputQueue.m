@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+
+#import "AMDInputQueue.h"
+
+amd_input_queue_t *amd_input_queue_create(size_t capacity)
+{
+	amd_input_queue_t *queue;
+	size_t size = 1;
+
+	while(size < capacity)
+		size <<= 1;
+
+	queue = calloc(1, sizeof(amd_input_queue_t));
+	if AMD_UNLIKELY(queue == NULL)
+		return NULL;
+
+	queue->events = calloc(size, sizeof(amd_input_event_t));
+	if AMD_UNLIKELY(queue->events == NULL) {
+		free(queue);
+		return NULL;
+	}
+
+	queue->mask = size - 1;
+	atomic_init(&queue->head, 0);
+	atomic_init(&queue->tail, 0);
+	atomic_init(&queue->overflows, 0);
+
+	return queue;
+}
+
+void amd_input_queue_destroy(amd_input_queue_t *queue)
+{
+	if(queue == NULL)
+		return;
+
+	free(queue->events);
+	free(queue);
+}
+
+bool amd_input_queue_push(amd_input_queue_t *queue, const amd_input_event_t *event)
+{
+	size_t head, tail;
+
+	tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+	head = atomic_load_explicit(&queue->head, memory_order_acquire);
+
+	if AMD_UNLIKELY(tail - head > queue->mask) {
+		atomic_fetch_add_explicit(&queue->overflows, 1, memory_order_relaxed);
+		return false;
+	}
+
+	queue->events[tail & queue->mask] = *event;
+
+	// Publish the event only after it is written
+	atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+	return true;
+}
+
+bool amd_input_queue_pop(amd_input_queue_t *queue, amd_input_event_t *event)
+{
+	size_t head, tail;
+
+	head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+	tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+	if(head == tail)
+		return false;
+
+	*event = queue->events[head & queue->mask];
+
+	// Give the slot back only after it is read
+	atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+
+	return true;
+}
+
+void amd_input_queue_clear(amd_input_queue_t *queue)
+{
+	size_t tail;
+
+	tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+	atomic_store_explicit(&queue->head, tail, memory_order_release);
+}
+
+size_t amd_input_queue_count(amd_input_queue_t *queue)
+{
+	size_t head, tail;
+
+	head = atomic_load_explicit(&queue->head, memory_order_acquire);
+	tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+
+	return tail - head;
+}
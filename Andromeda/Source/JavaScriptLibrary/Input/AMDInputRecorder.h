@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDInputDevice.h"
+#import "AMDGamepadBackend.h"
+
+@class AMDGamepadManager;
+
+/// Magic number at the start of an input recording: "AMDI".
+#define AMD_INPUT_RECORDING_MAGIC		0x49444D41
+
+/// Version of the input recording format.
+#define AMD_INPUT_RECORDING_VERSION		2
+
+/// Header of an input recording.
+typedef struct __attribute__((packed)) amd_input_recording_header_s {
+	uint32_t magic;
+	uint16_t version;
+	/// Size of a record, in bytes.
+	uint16_t recordSize;
+} amd_input_recording_header_t;
+
+/**
+ * A recorded input event, or for AMD_INPUT_DEVICE_GAMEPAD the state
+ * of a gamepad after a poll. Stored in host byte order.
+ */
+typedef struct __attribute__((packed)) amd_input_record_s {
+	/// Time since the start of the recording, in seconds.
+	double time;
+	union {
+		struct __attribute__((packed)) {
+			float x;
+			float y;
+			uint16_t code;
+			uint16_t modifiers;
+		};
+		amd_gamepad_state_t gamepad;
+	};
+	/// An amd_input_device_t.
+	uint8_t device;
+	uint8_t flags;
+	/// Index of the gamepad, for gamepad states.
+	uint16_t index;
+} amd_input_record_t;
+
+/**
+ * @brief Records input events and plays them back.
+ *
+ * A recording is a header followed by fixed-size records, one per
+ * event handled by a device, with the time relative to the start of
+ * the recording. Gamepads are recorded by state instead: every poll
+ * that changes a gamepad adds its complete state, axes included.
+ *
+ * Playing back a recording feeds the events to the devices again, at
+ * the same times, and publishes the gamepad states through the
+ * AMDGamepadManager in place of its backend, so a play session can be
+ * repeated exactly in a headless run.
+ */
+@interface AMDInputRecorder : NSObject
+
+/// Whether events are being recorded.
+@property (readonly) BOOL recording;
+
+/// Number of events in the current recording.
+@property (readonly) NSUInteger numberOfRecordedEvents;
+
+/// Number of events of the loaded replay not yet played back.
+@property (readonly) NSUInteger numberOfPendingReplayEvents;
+
+/// Manager whose gamepad states are recorded and replayed. Not retained.
+@property (weak) AMDGamepadManager *gamepadManager;
+
+/**
+ * Add a device to play back events for.
+ *
+ * @param device The device. Not retained.
+ */
+- (void)addDevice:(AMDInputDevice *)device;
+
+/**
+ * Start a new recording. Discards the previous one.
+ */
+- (void)startRecording;
+
+/**
+ * Stop recording.
+ *
+ * @return The recording, or nil if not recording.
+ */
+- (NSData *)stopRecording;
+
+/**
+ * Add an event to the recording. Called by the devices.
+ *
+ * @param event The event.
+ * @param device The kind of device that handled it.
+ */
+- (void)recordEvent:(const amd_input_event_t *)event device:(amd_input_device_t)device;
+
+/**
+ * Add the states of the gamepads after a poll to the recording.
+ *
+ * Called by the AMDGamepadManager after every poll, on its polling
+ * thread. Only gamepads that changed since the last recorded state
+ * are added.
+ *
+ * @param states The states.
+ * @param count Number of states.
+ * @param timestamp Time of the poll, in seconds since system startup.
+ */
+- (void)recordGamepadStates:(const amd_gamepad_state_t *)states
+					  count:(NSUInteger)count
+				  timestamp:(double)timestamp;
+
+/**
+ * Load a recording for playback.
+ *
+ * From then on, the gamepad manager publishes the replayed gamepad
+ * states instead of those of its backend.
+ *
+ * @param recording The recording.
+ * @return YES on success, NO if the recording is invalid.
+ */
+- (BOOL)loadReplay:(NSData *)recording;
+
+/**
+ * Play back all events up to a point in time.
+ *
+ * @param time Time since the start of the replay, in seconds.
+ * @return The number of events played back.
+ */
+- (NSUInteger)replayEventsUntilTime:(double)time;
+
+@end
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDInputRecorder.h"
+#import "AMDGamepadManager.h"
+
+static BOOL amd_gamepad_state_equal(const amd_gamepad_state_t *a, const amd_gamepad_state_t *b);
+
+@implementation AMDInputRecorder {
+	NSHashTable *_devices;
+
+	NSMutableData *_recording;
+	double _recordingStartTime;
+
+	// Last recorded gamepad states, to only record changes
+	amd_gamepad_state_t _recordedGamepadStates[AMD_GAMEPAD_MAX_DEVICES];
+
+	NSData *_replay;
+	NSUInteger _replayIndex;
+	NSUInteger _replayCount;
+}
+
+- (instancetype)init
+{
+	self = [super init];
+	if(self) {
+		_devices = [NSHashTable weakObjectsHashTable];
+	}
+	return self;
+}
+
+- (void)addDevice:(AMDInputDevice *)device
+{
+	[_devices addObject:device];
+}
+
+#pragma mark - Recording
+
+- (void)startRecording
+{
+	amd_input_recording_header_t header;
+
+	header.magic = AMD_INPUT_RECORDING_MAGIC;
+	header.version = AMD_INPUT_RECORDING_VERSION;
+	header.recordSize = sizeof(amd_input_record_t);
+
+	@synchronized(self) {
+		_recording = [NSMutableData dataWithCapacity:sizeof(header) + 1024 * sizeof(amd_input_record_t)];
+		[_recording appendBytes:&header length:sizeof(header)];
+
+		// Same clock as NSEvent timestamps
+		_recordingStartTime = [[NSProcessInfo processInfo] systemUptime];
+
+		// Replay starts with no gamepads, like the manager
+		bzero(_recordedGamepadStates, sizeof(_recordedGamepadStates));
+	}
+}
+
+- (NSData *)stopRecording
+{
+	NSData *recording;
+
+	@synchronized(self) {
+		recording = _recording;
+		_recording = nil;
+	}
+
+	return recording;
+}
+
+- (BOOL)recording
+{
+	@synchronized(self) {
+		return _recording != nil;
+	}
+}
+
+- (NSUInteger)numberOfRecordedEvents
+{
+	@synchronized(self) {
+		if(_recording == nil)
+			return 0;
+		return (_recording.length - sizeof(amd_input_recording_header_t)) / sizeof(amd_input_record_t);
+	}
+}
+
+- (void)recordEvent:(const amd_input_event_t *)event device:(amd_input_device_t)device
+{
+	amd_input_record_t record;
+
+	record.x = event->x;
+	record.y = event->y;
+	record.code = event->code;
+	record.modifiers = event->modifiers;
+	record.device = device;
+	record.flags = event->flags;
+	record.index = 0;
+
+	@synchronized(self) {
+		if(_recording == nil)
+			return;
+
+		record.time = MAX(event->timestamp - _recordingStartTime, 0.0);
+		[_recording appendBytes:&record length:sizeof(record)];
+	}
+}
+
+- (void)recordGamepadStates:(const amd_gamepad_state_t *)states
+					  count:(NSUInteger)count
+				  timestamp:(double)timestamp
+{
+	amd_input_record_t record;
+
+	bzero(&record, sizeof(record));
+	record.device = AMD_INPUT_DEVICE_GAMEPAD;
+
+	@synchronized(self) {
+		if(_recording == nil)
+			return;
+
+		record.time = MAX(timestamp - _recordingStartTime, 0.0);
+
+		for(NSUInteger i = 0; i < MIN(count, AMD_GAMEPAD_MAX_DEVICES); ++i) {
+			if(amd_gamepad_state_equal(&states[i], &_recordedGamepadStates[i]))
+				continue;
+
+			_recordedGamepadStates[i] = states[i];
+
+			record.gamepad = states[i];
+			record.index = (uint16_t)i;
+			[_recording appendBytes:&record length:sizeof(record)];
+		}
+	}
+}
+
+#pragma mark - Playback
+
+- (BOOL)loadReplay:(NSData *)recording
+{
+	const amd_input_recording_header_t *header;
+
+	if(recording.length < sizeof(amd_input_recording_header_t))
+		return NO;
+
+	header = recording.bytes;
+	if(header->magic != AMD_INPUT_RECORDING_MAGIC
+	   || header->version != AMD_INPUT_RECORDING_VERSION
+	   || header->recordSize != sizeof(amd_input_record_t))
+		return NO;
+
+	_replay = recording;
+	_replayIndex = 0;
+	_replayCount = (recording.length - sizeof(amd_input_recording_header_t)) / sizeof(amd_input_record_t);
+
+	_gamepadManager.replaying = YES;
+
+	return YES;
+}
+
+- (NSUInteger)numberOfPendingReplayEvents
+{
+	return _replayCount - _replayIndex;
+}
+
+- (NSUInteger)replayEventsUntilTime:(double)time
+{
+	const amd_input_record_t *records;
+	NSUInteger start = _replayIndex;
+
+	if(_replay == nil)
+		return 0;
+
+	records = (const amd_input_record_t *)((const uint8_t *)_replay.bytes
+										   + sizeof(amd_input_recording_header_t));
+
+	while(_replayIndex < _replayCount && records[_replayIndex].time <= time) {
+		amd_input_record_t record;
+		amd_input_event_t event;
+
+		record = records[_replayIndex++];
+
+		if(record.device == AMD_INPUT_DEVICE_GAMEPAD) {
+			[_gamepadManager replayState:&record.gamepad
+							   ofGamepad:record.index
+							   timestamp:record.time];
+			continue;
+		}
+
+		event.timestamp = record.time;
+		event.x = record.x;
+		event.y = record.y;
+		event.code = record.code;
+		event.modifiers = record.modifiers;
+		event.flags = record.flags;
+
+		for(AMDInputDevice *device in _devices) {
+			if(device.deviceType == record.device) {
+				[device handleInputEvent:&event];
+				break;
+			}
+		}
+	}
+
+	return _replayIndex - start;
+}
+
+@end
+
+/**
+ * Compare two gamepad states by field, as the padding of either
+ * may hold anything.
+ */
+static BOOL amd_gamepad_state_equal(const amd_gamepad_state_t *a, const amd_gamepad_state_t *b)
+{
+	return a->buttons == b->buttons
+		&& a->numberOfButtons == b->numberOfButtons
+		&& a->numberOfAxes == b->numberOfAxes
+		&& a->connected == b->connected
+		&& memcmp(a->axes, b->axes, sizeof(a->axes)) == 0;
+}
@@ -133,6 +133,22 @@ typedef enum spr_keyboard_key_e : uint8_t {
 	AMD_KEY_INSERT = 255,
 } spr_keyboard_key_t;
 
+/// Size of a bitset with a bit for every key, in bytes.
+#define AMD_KEY_BITSET_SIZE 32
+
+/**
+ * Key state, as bitsets indexed by key: bit (key & 7) of byte
+ * (key >> 3).
+ */
+typedef struct amd_key_state_s {
+	/// Keys that are down.
+	uint8_t held[AMD_KEY_BITSET_SIZE];
+	/// Keys that went down since the previous update.
+	uint8_t pressed[AMD_KEY_BITSET_SIZE];
+	/// Keys that went up since the previous update.
+	uint8_t released[AMD_KEY_BITSET_SIZE];
+} amd_key_state_t;
+
 /**
  * @brief Keyboard input device: JavaScript exports.
  */
@@ -184,10 +200,24 @@ L8_EXPORT_AS(getKeyString,
  */
 - (void)clearQueue;
 
+/**
+ * Update Keyboard.state to the current key state.
+ *
+ * Keyboard.state is a Uint8Array with the held, pressed and released
+ * bitsets of an amd_key_state_t. Call this once per frame, then use
+ * isHeld(), wasPressed() and wasReleased() on Keyboard, which only
+ * read the array and do not call into native code.
+ */
+- (void)updateState;
+
 @end
 
 /**
  * @brief Keyboard input device.
+ *
+ * Key events change a live key state. The state is copied to the
+ * script once per update, so the script sees a consistent state for
+ * a whole frame, and no key press is missed between updates.
  */
 @interface AMDKeyboard : AMDInputDevice <AMDKeyboard>
 
@@ -24,13 +24,31 @@
  */
 
 #import "AMDKeyboard.h"
-#import "NSMutableArray+AMDQueue.h"
+
+/**
+ * Adds the functions that read Keyboard.state.
+ */
+static NSString *const AMDKeyboardStateScript = @
+"(function (keyboard, state) {\n"
+"	keyboard.isHeld = function (key) {\n"
+"		return (state[key >> 3] & (1 << (key & 7))) !== 0;\n"
+"	};\n"
+"	keyboard.wasPressed = function (key) {\n"
+"		return (state[32 + (key >> 3)] & (1 << (key & 7))) !== 0;\n"
+"	};\n"
+"	keyboard.wasReleased = function (key) {\n"
+"		return (state[64 + (key >> 3)] & (1 << (key & 7))) !== 0;\n"
+"	};\n"
+"})";
+
+#define AMD_KEY_BIT_SET(bitset, key) ((bitset)[(key) >> 3] |= (uint8_t)(1 << ((key) & 7)))
+#define AMD_KEY_BIT_CLEAR(bitset, key) ((bitset)[(key) >> 3] &= (uint8_t)~(1 << ((key) & 7)))
+#define AMD_KEY_BIT_TEST(bitset, key) (((bitset)[(key) >> 3] >> ((key) & 7)) & 1)
 
 @implementation AMDKeyboard {
 	id _monitor;
-	NSMutableArray *_queue;
-	spr_keyboard_key_t _keyStatus[256];
-	size_t _numKeysPressed;
+	amd_key_state_t _liveState;
+	L8ArrayBuffer *_stateBuffer;
 }
 
 - (instancetype)init
@@ -40,36 +58,37 @@
 		NSEventMask mask;
 		NSEvent *(^eventHandler)(NSEvent *);
 
-		_queue = [[NSMutableArray alloc] init];
-		bzero(_keyStatus, 256);
+		bzero(&_liveState, sizeof(_liveState));
 
 		eventHandler = ^NSEvent *(NSEvent *event) {
-			unsigned short keyCode;
+			amd_input_event_t input;
 
-			if(event.isARepeat)
-				return nil;
-
-			keyCode = event.keyCode;
-
-			if AMD_LIKELY(keyCode >= 0 && keyCode < 255) {
-				if(event.type == NSKeyDown) {
-					_keyStatus[keyCode + 1] = 1;
-					[self triggerEvent:@"keydown" withArguments:@[@(keyCode)]];
-				} else {
-					_keyStatus[keyCode + 1] = 0;
-					[self triggerEvent:@"keyup" withArguments:@[@(keyCode)]];
-				}
+			input.timestamp = event.timestamp;
+			input.x = 0;
+			input.y = 0;
+			input.modifiers = (event.modifierFlags & NSDeviceIndependentModifierFlagsMask) >> 16;
+
+			// Modifier changes have no key, but are kept for replays
+			if(event.type == NSFlagsChanged) {
+				input.code = AMD_KEY_NONE;
+				input.flags = 0;
+				[self handleInputEvent:&input];
+
+				return event;
 			}
 
-			// TODO: add possibly more information, like MOD states.
-			[_queue enqueue:@(keyCode + 1)];
+			input.code = event.keyCode + 1;
+			input.flags = (event.type == NSKeyDown) ? AMD_INPUT_EVENT_PRESSED : 0;
+			if(event.isARepeat)
+				input.flags |= AMD_INPUT_EVENT_REPEAT;
+			[self handleInputEvent:&input];
 
 			// TODO: Make it possible to move keys upwards,
 			// so that CMD+Q is closing the app.
 			return nil;
 		};
 
-		mask = NSKeyDownMask | NSKeyUpMask;
+		mask = NSKeyDownMask | NSKeyUpMask | NSFlagsChangedMask;
         _monitor = [NSEvent addLocalMonitorForEventsMatchingMask:mask
 														 handler:eventHandler];
     }
@@ -80,7 +99,7 @@
 {
 	[super installInstanceIntoContext:context];
 
-	L8Value *keyboard, *keys;
+	L8Value *keyboard, *keys, *buffer, *state;
 
 	keyboard = [L8Value valueWithObject:self inContext:context];
 	keys = [L8Value valueWithNewObjectInContext:context];
@@ -179,6 +198,16 @@
 	SET_KEY(NUM_9)
 
 	keyboard[@"Key"] = keys;
+
+	// The script reads this buffer directly, see -updateState
+	buffer = [L8Value valueWithArrayBufferOfLength:sizeof(amd_key_state_t)
+										 inContext:context];
+	_stateBuffer = [buffer toArrayBuffer];
+	state = [context[@"Uint8Array"] constructWithArguments:@[buffer]];
+	keyboard[@"state"] = state;
+	[[context evaluateScript:AMDKeyboardStateScript withName:@"keyboard_state.js"]
+	 callWithArguments:@[keyboard, state]];
+
 	context[@"Input"][@"Keyboard"] = keyboard;
 }
 
@@ -190,20 +219,62 @@
 	}
 }
 
+- (amd_input_device_t)deviceType
+{
+	return AMD_INPUT_DEVICE_KEYBOARD;
+}
+
+- (void)handleInputEvent:(const amd_input_event_t *)event
+{
+	unsigned short keyCode;
+
+	[super handleInputEvent:event];
+
+	if(event->code == AMD_KEY_NONE || (event->flags & AMD_INPUT_EVENT_REPEAT))
+		return;
+
+	keyCode = event->code - 1;
+
+	if AMD_LIKELY(keyCode < 255) {
+		if(event->flags & AMD_INPUT_EVENT_PRESSED) {
+			AMD_KEY_BIT_SET(_liveState.held, event->code);
+			AMD_KEY_BIT_SET(_liveState.pressed, event->code);
+			[self triggerEvent:@"keydown" withArguments:@[@(keyCode)]];
+		} else {
+			AMD_KEY_BIT_CLEAR(_liveState.held, event->code);
+			AMD_KEY_BIT_SET(_liveState.released, event->code);
+			[self triggerEvent:@"keyup" withArguments:@[@(keyCode)]];
+		}
+	}
+
+	amd_input_queue_push(self.queue, event);
+}
+
 - (spr_keyboard_key_t)getKey
 {
-	NSNumber *key;
+	amd_input_event_t input;
 
-	key = [_queue dequeue];
-	if(key)
-		return key.unsignedIntValue;
+	if(amd_input_queue_pop(self.queue, &input))
+		return (spr_keyboard_key_t)input.code;
 
 	return AMD_KEY_NONE;
 }
 
 - (void)clearQueue
 {
-	[_queue removeAllObjects];
+	amd_input_queue_clear(self.queue);
+}
+
+- (void)updateState
+{
+	if AMD_UNLIKELY(_stateBuffer == nil)
+		return;
+
+	memcpy(_stateBuffer.buffer, &_liveState, sizeof(amd_key_state_t));
+
+	// Edges are reported once
+	bzero(_liveState.pressed, AMD_KEY_BITSET_SIZE);
+	bzero(_liveState.released, AMD_KEY_BITSET_SIZE);
 }
 
 - (BOOL)isKeyPressed
@@ -237,7 +308,18 @@
 		}
 	}
 
-	return _keyStatus[key];
+	if(key == AMD_KEY_NONE) {
+		for(size_t i = 0; i < AMD_KEY_BITSET_SIZE; ++i) {
+			if(_liveState.held[i])
+				return YES;
+		}
+		return NO;
+	}
+
+	if(key > 255)
+		return NO;
+
+	return AMD_KEY_BIT_TEST(_liveState.held, key);
 }
 
 - (BOOL)getToggleState:(spr_keyboard_key_t)key
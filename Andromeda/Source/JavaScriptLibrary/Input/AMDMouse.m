@@ -24,7 +24,6 @@
  */
 
 #import "AMDMouse.h"
-#import "NSMutableArray+AMDQueue.h"
 #import "AMDCoordinateUtilities.h"
 
 @implementation AMDMouse
@@ -115,9 +114,19 @@
 
 @end
 
+/**
+ * Add a wheel event to a queue.
+ *
+ * @param queue The queue.
+ * @param wheelEvent The wheel event.
+ * @param event The scroll event.
+ */
+static void amd_mouse_wheel_push(amd_input_queue_t *queue,
+								 spr_mouse_wheel_event_t wheelEvent,
+								 const amd_input_event_t *event);
+
 @implementation AMDMouseWheel {
 	id _monitor;
-	NSMutableArray *_queue;
 }
 
 - (instancetype)init
@@ -126,28 +135,19 @@
     if (self) {
 		NSEvent *(^eventHandler)(NSEvent *);
 
-		_queue = [[NSMutableArray alloc] init];
+		// Scrolling fires many events a frame: deliver their sum once
+		[self setCoalescing:AMDEventCoalescingSum forEvent:@"scroll"];
 
 		eventHandler = ^NSEvent *(NSEvent *event) {
-			float deltaX, deltaY;
-
-			deltaX = event.deltaX;
-			deltaY = event.deltaY;
-
-			// Do not handle scrolling smaller than 1.0
-			// to make the precise scrolling of OSX usable
-			// in the Sphere-style games.
-			if(deltaY >= 1.0)
-				[_queue enqueue:@(AMD_MOUSE_WHEEL_DOWN)];
-			else if(deltaY <= -1.0)
-				[_queue enqueue:@(AMD_MOUSE_WHEEL_UP)];
+			amd_input_event_t input;
 
-			if(deltaX >= 1.0)
-				[_queue enqueue:@(AMD_MOUSE_WHEEL_RIGHT)];
-			else if(deltaX <= -1.0)
-				[_queue enqueue:@(AMD_MOUSE_WHEEL_LEFT)];
-
-			[self triggerEvent:@"scroll" withArguments:@[@(deltaX),@(deltaY)]];
+			input.timestamp = event.timestamp;
+			input.x = event.deltaX;
+			input.y = event.deltaY;
+			input.code = AMD_MOUSE_WHEEL_NONE;
+			input.modifiers = (event.modifierFlags & NSDeviceIndependentModifierFlagsMask) >> 16;
+			input.flags = 0;
+			[self handleInputEvent:&input];
 
 			return event;
 		};
@@ -185,20 +185,55 @@
 	}
 }
 
+- (amd_input_device_t)deviceType
+{
+	return AMD_INPUT_DEVICE_MOUSE_WHEEL;
+}
+
+- (void)handleInputEvent:(const amd_input_event_t *)event
+{
+	[super handleInputEvent:event];
+
+	// Do not handle scrolling smaller than 1.0
+	// to make the precise scrolling of OSX usable
+	// in the Sphere-style games.
+	if(event->y >= 1.0)
+		amd_mouse_wheel_push(self.queue, AMD_MOUSE_WHEEL_DOWN, event);
+	else if(event->y <= -1.0)
+		amd_mouse_wheel_push(self.queue, AMD_MOUSE_WHEEL_UP, event);
+
+	if(event->x >= 1.0)
+		amd_mouse_wheel_push(self.queue, AMD_MOUSE_WHEEL_RIGHT, event);
+	else if(event->x <= -1.0)
+		amd_mouse_wheel_push(self.queue, AMD_MOUSE_WHEEL_LEFT, event);
+
+	[self triggerEvent:@"scroll" withArguments:@[@(event->x),@(event->y)]];
+}
+
 - (spr_mouse_wheel_event_t)getEvent
 {
-	NSNumber *event;
+	amd_input_event_t input;
 
-	event = [_queue dequeue];
-	if(event)
-		return [event unsignedIntValue];
+	if(amd_input_queue_pop(self.queue, &input))
+		return (spr_mouse_wheel_event_t)input.code;
 
 	return AMD_MOUSE_WHEEL_NONE;
 }
 
 - (void)clearQueue
 {
-	[_queue removeAllObjects];
+	amd_input_queue_clear(self.queue);
 }
 
 @end
+
+static void amd_mouse_wheel_push(amd_input_queue_t *queue,
+								 spr_mouse_wheel_event_t wheelEvent,
+								 const amd_input_event_t *event)
+{
+	amd_input_event_t input = *event;
+
+	input.code = wheelEvent;
+
+	amd_input_queue_push(queue, &input);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDGamepadBackend.h"
+
+/**
+ * @brief Gamepads without hardware.
+ *
+ * The state of the gamepads is set in code. Used in headless runs and
+ * tests, where no real devices may be used.
+ */
+@interface AMDVirtualGamepadBackend : NSObject <AMDGamepadBackend>
+
+/**
+ * Connect or disconnect a virtual gamepad.
+ *
+ * @param connected YES to connect.
+ * @param index Index of the gamepad.
+ * @param buttons Number of buttons.
+ * @param axes Number of axes.
+ */
+- (void)setConnected:(BOOL)connected
+		  forGamepad:(NSUInteger)index
+	 numberOfButtons:(NSUInteger)buttons
+		numberOfAxes:(NSUInteger)axes;
+
+/**
+ * Press or release a button.
+ *
+ * @param button The button, starting at 1.
+ * @param pressed YES when pressed.
+ * @param index Index of the gamepad.
+ */
+- (void)setButton:(NSUInteger)button pressed:(BOOL)pressed forGamepad:(NSUInteger)index;
+
+/**
+ * Move an axis.
+ *
+ * @param axis The axis.
+ * @param value Position, from -1.0 to 1.0.
+ * @param index Index of the gamepad.
+ */
+- (void)setAxis:(NSUInteger)axis value:(float)value forGamepad:(NSUInteger)index;
+
+@end
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDVirtualGamepadBackend.h"
+
+@implementation AMDVirtualGamepadBackend {
+	amd_gamepad_state_t _states[AMD_GAMEPAD_MAX_DEVICES];
+}
+
+- (BOOL)open
+{
+	return YES;
+}
+
+- (void)close
+{
+}
+
+- (NSUInteger)pollStates:(amd_gamepad_state_t *)states count:(NSUInteger)count
+{
+	NSUInteger found = 0;
+
+	@synchronized(self) {
+		for(NSUInteger i = 0; i < AMD_GAMEPAD_MAX_DEVICES; ++i) {
+			if(!_states[i].connected)
+				continue;
+			if(found == count)
+				break;
+			states[found++] = _states[i];
+		}
+	}
+
+	return found;
+}
+
+- (void)setConnected:(BOOL)connected
+		  forGamepad:(NSUInteger)index
+	 numberOfButtons:(NSUInteger)buttons
+		numberOfAxes:(NSUInteger)axes
+{
+	if(index >= AMD_GAMEPAD_MAX_DEVICES)
+		return;
+
+	@synchronized(self) {
+		bzero(&_states[index], sizeof(amd_gamepad_state_t));
+		_states[index].connected = connected;
+		_states[index].numberOfButtons = MIN(buttons, AMD_GAMEPAD_MAX_BUTTONS);
+		_states[index].numberOfAxes = MIN(axes, AMD_GAMEPAD_MAX_AXES);
+	}
+}
+
+- (void)setButton:(NSUInteger)button pressed:(BOOL)pressed forGamepad:(NSUInteger)index
+{
+	if(index >= AMD_GAMEPAD_MAX_DEVICES || button == 0 || button > AMD_GAMEPAD_MAX_BUTTONS)
+		return;
+
+	@synchronized(self) {
+		if(pressed)
+			_states[index].buttons |= (1u << (button - 1));
+		else
+			_states[index].buttons &= ~(1u << (button - 1));
+	}
+}
+
+- (void)setAxis:(NSUInteger)axis value:(float)value forGamepad:(NSUInteger)index
+{
+	if(index >= AMD_GAMEPAD_MAX_DEVICES || axis >= AMD_GAMEPAD_MAX_AXES)
+		return;
+
+	@synchronized(self) {
+		_states[index].axes[axis] = MAX(-1.0f, MIN(value, 1.0f));
+	}
+}
+
+@end
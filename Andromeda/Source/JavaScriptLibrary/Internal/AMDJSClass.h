@@ -24,6 +24,7 @@
  */
 
 #import <L8Framework/L8.h>
+#import "AMDRegistry.h"
 
 /**
  * @brief A protocol used by auto-installed JavaScript classes.
@@ -43,9 +44,25 @@
 
 @end
 
+/**
+ * Register a JS Lib class, to be installed by spr_install_js_lib.
+ *
+ * Use once, in the implementation file of the class.
+ *
+ * @param cls The class.
+ * @param global Name of the global installIntoContext: creates,
+ * a C string.
+ */
+#define AMD_REGISTER_JS_CLASS(cls, global) \
+	AMD_REGISTRY_ADD(AMD_REGISTRY_SECTION_JS_CLASSES, cls, global)
+
 /**
  * Install all JS Lib classes into given context.
- * A JS Lib class conforms to AMDJSClass.
+ * A JS Lib class conforms to AMDJSClass and is registered
+ * with AMD_REGISTER_JS_CLASS.
+ *
+ * Classes are installed when their global is first used, so
+ * the startup time does not depend on the size of the library.
  *
  * @param context the L8Context to install into
  */
@@ -25,21 +25,30 @@
 
 #include <objc/runtime.h>
 #import "AMDJSClass.h"
+#import "L8Value+AMDLazyProperties.h"
 
 void spr_install_js_lib(L8Context *context) {
-	Class *classes;
-	unsigned int count;
+	const amd_registry_entry_t *entries;
+	size_t count;
+	L8Value *global;
+	__weak L8Context *weakContext = context;
 
-	classes = objc_copyClassList(&count);
-	for(unsigned int i = 0; i < count; i++) {
-		// Class must conform to the protocol
-		if(!class_conformsToProtocol(classes[i], @protocol(AMDJSClass)))
-			continue;
+	global = context.globalObject;
 
-		// Install...
-		if([classes[i] respondsToSelector:@selector(installIntoContext:)])
-			[classes[i] installIntoContext:context];
-	}
+	entries = amd_registry_get_entries(AMD_REGISTRY_SECTION_JS_CLASSES, &count);
+	for(size_t i = 0; i < count; i++) {
+		const char *className = entries[i].className;
+		NSString *name = @(entries[i].name);
+
+		// Install on first use
+		[global defineLazyProperty:name withBlock:^id{
+			L8Context *strongContext = weakContext;
+			Class cls = objc_getClass(className);
 
-	free(classes);
-}
\ No newline at end of file
+			if([cls respondsToSelector:@selector(installIntoContext:)])
+				[cls installIntoContext:strongContext];
+
+			return strongContext[name];
+		}];
+	}
+}
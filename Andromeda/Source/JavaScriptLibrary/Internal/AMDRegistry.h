@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+
+/// Segment of the registry sections.
+#define AMD_REGISTRY_SEGMENT			"__DATA"
+
+/// Section with the AMDBinding classes.
+#define AMD_REGISTRY_SECTION_BINDINGS	"__amd_bindings"
+
+/// Section with the AMDJSClass classes.
+#define AMD_REGISTRY_SECTION_JS_CLASSES	"__amd_jsclasses"
+
+/// A class registered at compile time.
+typedef struct amd_registry_entry_s {
+	/// Name the class is registered under.
+	const char *name;
+	/// Name of the class.
+	const char *className;
+} amd_registry_entry_t;
+
+/**
+ * Add a class to a registry section.
+ *
+ * The linker collects the entries of all files in the section, so
+ * finding the classes at startup does not involve the runtime: no
+ * class is loaded before it is used.
+ *
+ * @param section The section.
+ * @param cls The class.
+ * @param name Name of the entry, a C string.
+ */
+#define AMD_REGISTRY_ADD(section, cls, name) \
+	__attribute__((used, section(AMD_REGISTRY_SEGMENT "," section))) \
+	static const amd_registry_entry_t amd_registry_entry_##cls = { name, #cls }
+
+/**
+ * Get the entries of a registry section of the application.
+ *
+ * @param section The section.
+ * @param count Set to the number of entries.
+ * @return The entries, or NULL when there are none.
+ */
+const amd_registry_entry_t *amd_registry_get_entries(const char *section, size_t *count);
@@ -93,4 +93,26 @@ L8_EXPORT_AS(abort,
  */
 @interface AMDEngine : AMDEventEmitter <AMDEngine>
 
+/// Names of the bindings the game asked for so far, in order of first use.
+@property (readonly) NSArray *usedBindings;
+
+/**
+ * Set up bindings before the game asks for them.
+ *
+ * Unknown names are ignored. Must be called in the context.
+ *
+ * @param names Names of the bindings.
+ */
+- (void)warmUpBindings:(NSArray *)names;
+
+/**
+ * Set up the bindings used in the previous run of the game.
+ *
+ * The bindings used by a game hardly change between runs, so
+ * setting them up during startup, before the main module runs,
+ * removes that work from the first frames. Must be called in the
+ * context.
+ */
+- (void)warmUpPreviouslyUsedBindings;
+
 @end
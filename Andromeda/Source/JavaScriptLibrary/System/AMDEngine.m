@@ -25,13 +25,19 @@
 
 #import "AMDEngine.h"
 #import "AMDBinding.h"
+#import "AMDFileWatcher.h"
 
 #import <L8Framework/L8.h>
-#include <objc/runtime.h>
+#import <AndromedaKit/AndromedaKit.h>
+
+/// User defaults key of the bindings used in the last run.
+static NSString *const AMDEngineUsedBindingsKey = @"AMDEngineUsedBindings";
 
 @implementation AMDEngine {
 	NSMutableDictionary *_bindingCache;
 	NSDictionary *_bindings;
+	NSMutableArray *_usedBindings;
+	id _fileChangeObserver;
 }
 
 @synthesize mainModule=_mainModule, version=_version, versions=_versions;
@@ -42,6 +48,7 @@
 	if AMD_LIKELY(self) {
 		_bindingCache = [[NSMutableDictionary alloc] init];
 		_bindings = [self findAllBindings];
+		_usedBindings = [[NSMutableArray alloc] init];
 
 		// _extensions = @{@"sqlite":[[AMDEXTSQLite alloc] init]};
 		_version = @(10000); // TODO get from some build setting
@@ -49,56 +56,114 @@
 					  @"pegasus" : @"0.1",
 					  @"L8Framework" : @"0.1",
 					  @"v8" : @"3.24.40"};
+
+		// Changed resources are loaded again when asked for, and
+		// scripts reload changed modules on 'change'
+		__weak AMDEngine *weakSelf = self;
+		_fileChangeObserver = [[NSNotificationCenter defaultCenter] addObserverForName:AMDFilesDidChangeNotification
+																				object:nil
+																				 queue:nil
+																			usingBlock:^(NSNotification *notification) {
+			for(NSString *path in notification.userInfo[AMDFileWatcherPathsKey])
+				[[AMKResourceCache sharedCache] removeResourcesAtPath:path];
+
+			[weakSelf triggerEvent:@"change"
+					 withArguments:@[notification.userInfo[AMDFileWatcherPathsKey]]];
+		}];
 	}
 	return self;
 }
 
+- (void)dealloc
+{
+	[[NSNotificationCenter defaultCenter] removeObserver:_fileChangeObserver];
+}
+
 #pragma mark - Bindings
 
 - (NSDictionary *)findAllBindings
 {
-	Class *classes;
-	unsigned int count;
+	const amd_registry_entry_t *entries;
+	size_t count;
 	NSMutableDictionary *result;
 
-	result = [NSMutableDictionary dictionary];
-
-	classes = objc_copyClassList(&count);
-	for(unsigned int i = 0; i < count; i++) {
-		if(!class_conformsToProtocol(classes[i], @protocol(AMDBinding)))
-			continue;
-
-		result[[classes[i] bindingName]] = classes[i];
-	}
+	entries = amd_registry_get_entries(AMD_REGISTRY_SECTION_BINDINGS, &count);
 
-	free(classes);
+	// Only the names: classes are looked up when first used
+	result = [NSMutableDictionary dictionaryWithCapacity:count];
+	for(size_t i = 0; i < count; i++)
+		result[@(entries[i].name)] = @(entries[i].className);
 
 	return result;
 }
 
-- (L8Value *)bindingForBuiltin:(NSString *)builtin
+/**
+ * Set up a binding, or get it from the cache.
+ *
+ * @param name Name of the binding.
+ * @return The binding, or nil if there is no such binding.
+ */
+- (L8Value *)setUpBindingNamed:(NSString *)name
 {
+	Class<AMDBinding> bindingClass;
 	L8Value *binding;
 
-	binding = _bindingCache[builtin];
+	binding = _bindingCache[name];
 	if(binding != nil)
 		return binding;
 
-	if(_bindings[builtin]) {
-		Class<AMDBinding> bindingClass;
+	if(_bindings[name] == nil)
+		return nil;
 
-		bindingClass = _bindings[builtin];
+	bindingClass = NSClassFromString(_bindings[name]);
+	binding = [bindingClass setUpBinding];
 
-		binding = [bindingClass setUpBinding];
+	_bindingCache[name] = binding;
 
-		_bindingCache[builtin] = binding;
+	return binding;
+}
 
-		return binding;
-	} else
+- (L8Value *)bindingForBuiltin:(NSString *)builtin
+{
+	L8Value *binding;
+
+	binding = [self setUpBindingNamed:builtin];
+	if(binding == nil) {
 		[[L8Value valueWithNewErrorFromMessage:[NSString stringWithFormat:@"No such binding '%@'",builtin]
 									 inContext:[L8Context currentContext]] throwValue];
+		return nil;
+	}
+
+	// Remembered for the warm start of the next run. Warmed up
+	// bindings count only when the game asks for them.
+	if AMD_UNLIKELY(![_usedBindings containsObject:builtin]) {
+		[_usedBindings addObject:builtin];
+		[[NSUserDefaults standardUserDefaults] setObject:[_usedBindings copy]
+												  forKey:AMDEngineUsedBindingsKey];
+	}
+
+	return binding;
+}
+
+- (NSArray *)usedBindings
+{
+	return [_usedBindings copy];
+}
+
+- (void)warmUpBindings:(NSArray *)names
+{
+	for(NSString *name in names) {
+		if([name isKindOfClass:[NSString class]])
+			[self setUpBindingNamed:name];
+	}
+}
+
+- (void)warmUpPreviouslyUsedBindings
+{
+	NSArray *names;
 
-	return nil;
+	names = [[NSUserDefaults standardUserDefaults] arrayForKey:AMDEngineUsedBindingsKey];
+	[self warmUpBindings:names];
 }
 
 #pragma mark - Exiting the process
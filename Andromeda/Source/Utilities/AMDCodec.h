@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file
+ * @brief Base64 and hexadecimal codecs.
+ *
+ * The codecs work on plain memory, so they can write straight into
+ * ArrayBuffers and strings. Blocks of 12 (base64) or 16 (hex) bytes
+ * are done with SSSE3 when it is available, the rest with tables.
+ *
+ * The base64 decoder accepts both alphabets, skips any other
+ * characters, such as line breaks, and stops at the first '='. The hex
+ * decoder stops at the first invalid pair.
+ */
+
+/// Base64 alphabets.
+typedef enum amd_base64_alphabet_e : uint8_t {
+	AMD_BASE64_STANDARD, ///< '+' and '/', padded with '='.
+	AMD_BASE64_URL       ///< '-' and '_', not padded.
+} amd_base64_alphabet_t;
+
+/**
+ * Get the length of encoded base64 data.
+ *
+ * @param length Number of bytes to encode.
+ * @param alphabet The alphabet.
+ * @return Number of characters.
+ */
+size_t amd_base64_encoded_length(size_t length, amd_base64_alphabet_t alphabet);
+
+/**
+ * Get the maximum length of decoded base64 data.
+ *
+ * @param length Number of characters to decode.
+ * @return Maximum number of bytes.
+ */
+size_t amd_base64_decoded_length(size_t length);
+
+/**
+ * Encode bytes as base64.
+ *
+ * @param out Output of amd_base64_encoded_length() characters.
+ * @param in Bytes to encode.
+ * @param length Number of bytes.
+ * @param alphabet The alphabet.
+ * @return Number of characters written.
+ */
+size_t amd_base64_encode(char *out, const uint8_t *in, size_t length,
+						 amd_base64_alphabet_t alphabet);
+
+/**
+ * Decode base64 characters.
+ *
+ * @param out Output of amd_base64_decoded_length() bytes.
+ * @param in Characters to decode.
+ * @param length Number of characters.
+ * @return Number of bytes written.
+ */
+size_t amd_base64_decode(uint8_t *out, const char *in, size_t length);
+
+/**
+ * Encode bytes as lowercase hexadecimal.
+ *
+ * @param out Output of 2 * length characters.
+ * @param in Bytes to encode.
+ * @param length Number of bytes.
+ * @return Number of characters written.
+ */
+size_t amd_hex_encode(char *out, const uint8_t *in, size_t length);
+
+/**
+ * Decode hexadecimal characters, of any case.
+ *
+ * @param out Output of length / 2 bytes.
+ * @param in Characters to decode.
+ * @param length Number of characters.
+ * @return Number of bytes written.
+ */
+size_t amd_hex_decode(uint8_t *out, const char *in, size_t length);
+
+/**
+ * @brief State of a streaming base64 encoder.
+ *
+ * Encodes input given in chunks of any size. Bytes that do not fill a
+ * group of three are kept until the next chunk.
+ */
+typedef struct amd_base64_encoder_s {
+	uint8_t carry[3];
+	uint8_t carryLength;
+	amd_base64_alphabet_t alphabet;
+} amd_base64_encoder_t;
+
+/**
+ * @brief State of a streaming base64 or hex decoder.
+ *
+ * Decodes input given in chunks of any size. Characters that do not
+ * fill a group are kept until the next chunk.
+ */
+typedef struct amd_codec_decoder_s {
+	uint32_t bits;
+	uint8_t count;
+	bool finished;
+} amd_codec_decoder_t;
+
+/**
+ * Start streaming base64 encoding.
+ *
+ * @param encoder The encoder.
+ * @param alphabet The alphabet.
+ */
+void amd_base64_encoder_init(amd_base64_encoder_t *encoder, amd_base64_alphabet_t alphabet);
+
+/**
+ * Encode a chunk.
+ *
+ * @param encoder The encoder.
+ * @param out Output of amd_base64_encoded_length(length + 2) characters.
+ * @param in Bytes to encode.
+ * @param length Number of bytes.
+ * @return Number of characters written.
+ */
+size_t amd_base64_encoder_update(amd_base64_encoder_t *encoder, char *out,
+								 const uint8_t *in, size_t length);
+
+/**
+ * Finish encoding, writing the last group.
+ *
+ * @param encoder The encoder.
+ * @param out Output of 4 characters.
+ * @return Number of characters written.
+ */
+size_t amd_base64_encoder_final(amd_base64_encoder_t *encoder, char *out);
+
+/**
+ * Start streaming decoding.
+ *
+ * @param decoder The decoder.
+ */
+void amd_codec_decoder_init(amd_codec_decoder_t *decoder);
+
+/**
+ * Decode a chunk of base64.
+ *
+ * @param decoder The decoder.
+ * @param out Output of amd_base64_decoded_length(length) + 3 bytes.
+ * Bytes are only written for complete groups.
+ * @param in Characters to decode.
+ * @param length Number of characters.
+ * @return Number of bytes written.
+ */
+size_t amd_base64_decoder_update(amd_codec_decoder_t *decoder, uint8_t *out,
+								 const char *in, size_t length);
+
+/**
+ * Finish base64 decoding, writing the last incomplete group.
+ *
+ * @param decoder The decoder.
+ * @param out Output of 2 bytes.
+ * @return Number of bytes written.
+ */
+size_t amd_base64_decoder_final(amd_codec_decoder_t *decoder, uint8_t *out);
+
+/**
+ * Decode a chunk of hex.
+ *
+ * @param decoder The decoder.
+ * @param out Output of length / 2 + 1 bytes.
+ * @param in Characters to decode.
+ * @param length Number of characters.
+ * @return Number of bytes written.
+ */
+size_t amd_hex_decoder_update(amd_codec_decoder_t *decoder, uint8_t *out,
+							  const char *in, size_t length);
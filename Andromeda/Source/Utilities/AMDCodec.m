@@ -0,0 +1,515 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDCodec.h"
+
+#include <string.h>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+/// Decode table value of '='.
+#define AMD_CODEC_PAD 0xFE
+
+/// Decode table value of characters outside the alphabet.
+#define AMD_CODEC_INVALID 0xFF
+
+static const char amd_base64_alphabets[2][64] = {
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+};
+
+/// Values of base64 characters, of both alphabets.
+static const uint8_t amd_base64_values[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0x3E, 0xFF, 0x3F,
+	0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF,
+	0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+	0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F,
+	0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+/// Values of hexadecimal digits.
+static const uint8_t amd_hex_values[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+/// Hexadecimal representation of every byte.
+static const char amd_hex_pairs[513] =
+	"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+	"202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+	"404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+	"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+	"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+	"a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+	"c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+	"e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+/**
+ * Encode whole groups of three bytes.
+ *
+ * @param out Output characters.
+ * @param in Bytes to encode.
+ * @param length Number of bytes, only whole groups are encoded.
+ * @param alphabet The alphabet.
+ * @return Number of bytes encoded.
+ */
+static size_t amd_base64_encode_groups(char *out, const uint8_t *in, size_t length,
+									   amd_base64_alphabet_t alphabet);
+
+/**
+ * Encode the last one or two bytes.
+ *
+ * @param out Output characters.
+ * @param in Bytes to encode.
+ * @param length 1 or 2.
+ * @param alphabet The alphabet.
+ * @return Number of characters written.
+ */
+static size_t amd_base64_encode_tail(char *out, const uint8_t *in, size_t length,
+									 amd_base64_alphabet_t alphabet);
+
+#ifdef __SSSE3__
+/**
+ * Encode 12 bytes into 16 characters. Reads 16 bytes.
+ */
+static void amd_base64_encode_block_ssse3(char *out, const uint8_t *in,
+										  amd_base64_alphabet_t alphabet);
+
+/**
+ * Decode 16 characters of the standard alphabet into 12 bytes.
+ * Writes 16 bytes.
+ *
+ * @return false if the block contains any other character.
+ */
+static bool amd_base64_decode_block_ssse3(uint8_t *out, const uint8_t *in);
+
+/**
+ * Encode 16 bytes into 32 hexadecimal characters.
+ */
+static void amd_hex_encode_block_ssse3(char *out, const uint8_t *in);
+#endif
+
+size_t amd_base64_encoded_length(size_t length, amd_base64_alphabet_t alphabet)
+{
+	if(alphabet == AMD_BASE64_URL)
+		return (length / 3) * 4 + (length % 3 ? length % 3 + 1 : 0);
+	return ((length + 2) / 3) * 4;
+}
+
+size_t amd_base64_decoded_length(size_t length)
+{
+	return ((length + 3) / 4) * 3;
+}
+
+size_t amd_base64_encode(char *out, const uint8_t *in, size_t length,
+						 amd_base64_alphabet_t alphabet)
+{
+	size_t done;
+
+	done = amd_base64_encode_groups(out, in, length, alphabet);
+
+	return (done / 3) * 4 + amd_base64_encode_tail(out + (done / 3) * 4, in + done,
+													length - done, alphabet);
+}
+
+size_t amd_base64_decode(uint8_t *out, const char *in, size_t length)
+{
+	amd_codec_decoder_t decoder;
+	size_t written;
+
+	amd_codec_decoder_init(&decoder);
+	written = amd_base64_decoder_update(&decoder, out, in, length);
+
+	return written + amd_base64_decoder_final(&decoder, out + written);
+}
+
+size_t amd_hex_encode(char *out, const uint8_t *in, size_t length)
+{
+	size_t i = 0;
+
+#ifdef __SSSE3__
+	for(; length - i >= 16; i += 16)
+		amd_hex_encode_block_ssse3(out + i * 2, in + i);
+#endif
+
+	for(; i < length; ++i)
+		memcpy(out + i * 2, amd_hex_pairs + in[i] * 2, 2);
+
+	return length * 2;
+}
+
+size_t amd_hex_decode(uint8_t *out, const char *in, size_t length)
+{
+	amd_codec_decoder_t decoder;
+
+	amd_codec_decoder_init(&decoder);
+
+	return amd_hex_decoder_update(&decoder, out, in, length);
+}
+
+#pragma mark - Streaming
+
+void amd_base64_encoder_init(amd_base64_encoder_t *encoder, amd_base64_alphabet_t alphabet)
+{
+	memset(encoder, 0, sizeof(*encoder));
+	encoder->alphabet = alphabet;
+}
+
+size_t amd_base64_encoder_update(amd_base64_encoder_t *encoder, char *out,
+								 const uint8_t *in, size_t length)
+{
+	size_t written = 0, done;
+
+	// Complete the group left by the previous chunk
+	if(encoder->carryLength > 0) {
+		while(encoder->carryLength < 3 && length > 0) {
+			encoder->carry[encoder->carryLength++] = *in++;
+			--length;
+		}
+		if(encoder->carryLength < 3)
+			return 0;
+
+		amd_base64_encode_groups(out, encoder->carry, 3, encoder->alphabet);
+		encoder->carryLength = 0;
+		written = 4;
+	}
+
+	done = amd_base64_encode_groups(out + written, in, length, encoder->alphabet);
+	written += (done / 3) * 4;
+
+	memcpy(encoder->carry, in + done, length - done);
+	encoder->carryLength = (uint8_t)(length - done);
+
+	return written;
+}
+
+size_t amd_base64_encoder_final(amd_base64_encoder_t *encoder, char *out)
+{
+	size_t written;
+
+	written = amd_base64_encode_tail(out, encoder->carry, encoder->carryLength,
+									 encoder->alphabet);
+	encoder->carryLength = 0;
+
+	return written;
+}
+
+void amd_codec_decoder_init(amd_codec_decoder_t *decoder)
+{
+	memset(decoder, 0, sizeof(*decoder));
+}
+
+size_t amd_base64_decoder_update(amd_codec_decoder_t *decoder, uint8_t *out,
+								 const char *chars, size_t length)
+{
+	const uint8_t *in = (const uint8_t *)chars;
+	size_t i = 0, o = 0;
+
+	if(decoder->finished)
+		return 0;
+
+	while(i < length) {
+		uint8_t value;
+
+		// Whole groups of valid characters go without any state
+		if(decoder->count == 0) {
+#ifdef __SSSE3__
+			// The block writes 16 bytes: keep 24 characters of room
+			while(length - i >= 24 && amd_base64_decode_block_ssse3(out + o, in + i)) {
+				i += 16;
+				o += 12;
+			}
+#endif
+			while(length - i >= 4) {
+				uint8_t a, b, c, d;
+
+				a = amd_base64_values[in[i]];
+				b = amd_base64_values[in[i + 1]];
+				c = amd_base64_values[in[i + 2]];
+				d = amd_base64_values[in[i + 3]];
+				if((a | b | c | d) & 0x80)
+					break;
+
+				out[o] = (uint8_t)(a << 2 | b >> 4);
+				out[o + 1] = (uint8_t)(b << 4 | c >> 2);
+				out[o + 2] = (uint8_t)(c << 6 | d);
+				i += 4;
+				o += 3;
+			}
+			if(i >= length)
+				break;
+		}
+
+		value = amd_base64_values[in[i++]];
+		if(value == AMD_CODEC_PAD) {
+			o += amd_base64_decoder_final(decoder, out + o);
+			decoder->finished = true;
+			break;
+		} else if(value == AMD_CODEC_INVALID)
+			continue;
+
+		decoder->bits = decoder->bits << 6 | value;
+		if(++decoder->count == 4) {
+			out[o] = (uint8_t)(decoder->bits >> 16);
+			out[o + 1] = (uint8_t)(decoder->bits >> 8);
+			out[o + 2] = (uint8_t)decoder->bits;
+			o += 3;
+
+			decoder->bits = 0;
+			decoder->count = 0;
+		}
+	}
+
+	return o;
+}
+
+size_t amd_base64_decoder_final(amd_codec_decoder_t *decoder, uint8_t *out)
+{
+	size_t written = 0;
+
+	// A single character holds less than a byte and is dropped
+	if(decoder->count == 2) {
+		out[0] = (uint8_t)(decoder->bits >> 4);
+		written = 1;
+	} else if(decoder->count == 3) {
+		out[0] = (uint8_t)(decoder->bits >> 10);
+		out[1] = (uint8_t)(decoder->bits >> 2);
+		written = 2;
+	}
+
+	decoder->bits = 0;
+	decoder->count = 0;
+
+	return written;
+}
+
+size_t amd_hex_decoder_update(amd_codec_decoder_t *decoder, uint8_t *out,
+							  const char *chars, size_t length)
+{
+	const uint8_t *in = (const uint8_t *)chars;
+	size_t i = 0, o = 0;
+
+	if(decoder->finished || length == 0)
+		return 0;
+
+	// Complete the pair left by the previous chunk
+	if(decoder->count == 1) {
+		uint8_t low = amd_hex_values[in[i++]];
+
+		if(low == AMD_CODEC_INVALID) {
+			decoder->finished = true;
+			return 0;
+		}
+		out[o++] = (uint8_t)(decoder->bits << 4 | low);
+		decoder->count = 0;
+	}
+
+	for(; length - i >= 2; i += 2) {
+		uint8_t high, low;
+
+		high = amd_hex_values[in[i]];
+		low = amd_hex_values[in[i + 1]];
+		if((high | low) & 0x80) {
+			decoder->finished = true;
+			return o;
+		}
+
+		out[o++] = (uint8_t)(high << 4 | low);
+	}
+
+	if(i < length) {
+		decoder->bits = amd_hex_values[in[i]];
+		if(decoder->bits == AMD_CODEC_INVALID)
+			decoder->finished = true;
+		else
+			decoder->count = 1;
+	}
+
+	return o;
+}
+
+#pragma mark - Kernels
+
+static size_t amd_base64_encode_groups(char *out, const uint8_t *in, size_t length,
+									   amd_base64_alphabet_t alphabet)
+{
+	const char *table = amd_base64_alphabets[alphabet];
+	size_t i = 0;
+
+#ifdef __SSSE3__
+	for(; length - i >= 16; i += 12, out += 16)
+		amd_base64_encode_block_ssse3(out, in + i, alphabet);
+#endif
+
+	for(; length - i >= 3; i += 3, out += 4) {
+		uint32_t group = (uint32_t)in[i] << 16 | (uint32_t)in[i + 1] << 8 | in[i + 2];
+
+		out[0] = table[group >> 18];
+		out[1] = table[(group >> 12) & 0x3F];
+		out[2] = table[(group >> 6) & 0x3F];
+		out[3] = table[group & 0x3F];
+	}
+
+	return i;
+}
+
+static size_t amd_base64_encode_tail(char *out, const uint8_t *in, size_t length,
+									 amd_base64_alphabet_t alphabet)
+{
+	const char *table = amd_base64_alphabets[alphabet];
+	size_t written;
+
+	if(length == 0)
+		return 0;
+
+	out[0] = table[in[0] >> 2];
+	if(length == 1) {
+		out[1] = table[(in[0] & 0x03) << 4];
+		written = 2;
+	} else {
+		out[1] = table[(in[0] & 0x03) << 4 | in[1] >> 4];
+		out[2] = table[(in[1] & 0x0F) << 2];
+		written = 3;
+	}
+
+	// Unpadded output is sized to the characters alone
+	if(alphabet == AMD_BASE64_URL)
+		return written;
+
+	for(; written < 4; ++written)
+		out[written] = '=';
+
+	return written;
+}
+
+#ifdef __SSSE3__
+static void amd_base64_encode_block_ssse3(char *out, const uint8_t *in,
+										  amd_base64_alphabet_t alphabet)
+{
+	__m128i bytes, indices, shifts, lookup, less;
+
+	// Spread three bytes over every 32 bits, then cut them into 6 bit indices
+	bytes = _mm_loadu_si128((const __m128i *)in);
+	bytes = _mm_shuffle_epi8(bytes, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+												 4, 5, 3, 4, 1, 2, 0, 1));
+	indices = _mm_or_si128(_mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)),
+										   _mm_set1_epi32(0x04000040)),
+						   _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)),
+										   _mm_set1_epi32(0x01000010)));
+
+	// Map each index to the offset of its range in the alphabet
+	if(alphabet == AMD_BASE64_URL)
+		lookup = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+							   '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '-' - 62,
+							   '_' - 63, 'A', 0, 0);
+	else
+		lookup = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+							   '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+							   '/' - 63, 'A', 0, 0);
+
+	shifts = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+	less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+	shifts = _mm_or_si128(shifts, _mm_and_si128(less, _mm_set1_epi8(13)));
+	shifts = _mm_shuffle_epi8(lookup, shifts);
+
+	_mm_storeu_si128((__m128i *)out, _mm_add_epi8(shifts, indices));
+}
+
+static bool amd_base64_decode_block_ssse3(uint8_t *out, const uint8_t *in)
+{
+	__m128i chars, high, low, shifts, values, merged;
+
+	chars = _mm_loadu_si128((const __m128i *)in);
+	high = _mm_and_si128(_mm_srli_epi32(chars, 4), _mm_set1_epi8(0x0F));
+	low = _mm_and_si128(chars, _mm_set1_epi8(0x0F));
+
+	// A character is valid when its nibbles share no bit in these tables
+	if(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(
+			_mm_shuffle_epi8(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+										   0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A), low),
+			_mm_shuffle_epi8(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+										   0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10), high)),
+			_mm_setzero_si128())) != 0)
+		return false;
+
+	// '/' shares its high nibble with '+', but needs a different shift
+	shifts = _mm_add_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('/')), high);
+	shifts = _mm_shuffle_epi8(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+											0, 0, 0, 0, 0, 0, 0, 0), shifts);
+	values = _mm_add_epi8(chars, shifts);
+
+	// Join four 6 bit values into three bytes, and pack those
+	merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+	merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+	merged = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9,
+													8, 14, 13, 12, -1, -1, -1, -1));
+
+	_mm_storeu_si128((__m128i *)out, merged);
+
+	return true;
+}
+
+static void amd_hex_encode_block_ssse3(char *out, const uint8_t *in)
+{
+	__m128i bytes, digits, high, low;
+
+	digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+						   '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+	bytes = _mm_loadu_si128((const __m128i *)in);
+
+	high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0F)));
+	low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, _mm_set1_epi8(0x0F)));
+
+	_mm_storeu_si128((__m128i *)out, _mm_unpacklo_epi8(high, low));
+	_mm_storeu_si128((__m128i *)(out + 16), _mm_unpackhi_epi8(high, low));
+}
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file
+ * @brief UTF-8 and UTF-16 transcoding.
+ *
+ * Runs of ASCII are checked and copied 16 bytes at a time with SSE2.
+ *
+ * Invalid UTF-8 and unpaired surrogates are replaced with U+FFFD, one
+ * for every maximal invalid subsequence, like browsers and node.
+ */
+
+/**
+ * Get the length of the ASCII prefix of bytes.
+ *
+ * @param in The bytes.
+ * @param length Number of bytes.
+ * @return Number of bytes before the first non-ASCII byte.
+ */
+size_t amd_ascii_length(const uint8_t *in, size_t length);
+
+/**
+ * Measure UTF-8 as UTF-16.
+ *
+ * @param in The UTF-8 bytes.
+ * @param length Number of bytes.
+ * @return Number of UTF-16 code units.
+ */
+size_t amd_utf8_utf16_length(const uint8_t *in, size_t length);
+
+/**
+ * Convert UTF-8 to UTF-16.
+ *
+ * @param out Output of amd_utf8_utf16_length() code units.
+ * @param in The UTF-8 bytes.
+ * @param length Number of bytes.
+ * @return Number of code units written.
+ */
+size_t amd_utf8_to_utf16(uint16_t *out, const uint8_t *in, size_t length);
+
+/**
+ * Measure UTF-16 as UTF-8.
+ *
+ * @param in The UTF-16 code units.
+ * @param length Number of code units.
+ * @return Number of UTF-8 bytes.
+ */
+size_t amd_utf16_utf8_length(const uint16_t *in, size_t length);
+
+/**
+ * Convert UTF-16 to UTF-8.
+ *
+ * @param out Output of amd_utf16_utf8_length() bytes.
+ * @param in The UTF-16 code units.
+ * @param length Number of code units.
+ * @return Number of bytes written.
+ */
+size_t amd_utf16_to_utf8(uint8_t *out, const uint16_t *in, size_t length);
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMDUnicode.h"
+
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/// Replacement character, for invalid input.
+#define AMD_UNICODE_REPLACEMENT 0xFFFD
+
+/**
+ * Decode one character of UTF-8.
+ *
+ * @param in The UTF-8 bytes.
+ * @param length Number of bytes.
+ * @param position Position of the character, moved past it. An invalid
+ * sequence is skipped up to the first byte that cannot continue it.
+ * @return The code point, or AMD_UNICODE_REPLACEMENT.
+ */
+static inline uint32_t amd_utf8_next(const uint8_t *in, size_t length, size_t *position);
+
+/**
+ * Get the length of the ASCII prefix of UTF-16.
+ *
+ * @param in The code units.
+ * @param length Number of code units.
+ * @return Number of code units before the first non-ASCII one.
+ */
+static size_t amd_utf16_ascii_length(const uint16_t *in, size_t length);
+
+size_t amd_ascii_length(const uint8_t *in, size_t length)
+{
+	size_t i = 0;
+
+#ifdef __SSE2__
+	for(; length - i >= 16; i += 16) {
+		int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(in + i)));
+
+		if(mask != 0)
+			return i + (size_t)__builtin_ctz((unsigned int)mask);
+	}
+#endif
+
+	for(; i < length; ++i) {
+		if(in[i] & 0x80)
+			break;
+	}
+
+	return i;
+}
+
+size_t amd_utf8_utf16_length(const uint8_t *in, size_t length)
+{
+	size_t i = 0, units = 0;
+
+	while(i < length) {
+		size_t ascii;
+		uint32_t code;
+
+		ascii = amd_ascii_length(in + i, length - i);
+		i += ascii;
+		units += ascii;
+		if(i >= length)
+			break;
+
+		code = amd_utf8_next(in, length, &i);
+		units += code > 0xFFFF ? 2 : 1;
+	}
+
+	return units;
+}
+
+size_t amd_utf8_to_utf16(uint16_t *out, const uint8_t *in, size_t length)
+{
+	size_t i = 0, o = 0;
+
+	while(i < length) {
+		uint32_t code;
+
+#ifdef __SSE2__
+		// Widen ASCII to 16 bits, 16 characters at a time
+		while(length - i >= 16) {
+			__m128i bytes = _mm_loadu_si128((const __m128i *)(in + i));
+
+			if(_mm_movemask_epi8(bytes) != 0)
+				break;
+
+			_mm_storeu_si128((__m128i *)(out + o), _mm_unpacklo_epi8(bytes, _mm_setzero_si128()));
+			_mm_storeu_si128((__m128i *)(out + o + 8), _mm_unpackhi_epi8(bytes, _mm_setzero_si128()));
+			i += 16;
+			o += 16;
+		}
+		if(i >= length)
+			break;
+#endif
+
+		if(in[i] < 0x80) {
+			out[o++] = in[i++];
+			continue;
+		}
+
+		code = amd_utf8_next(in, length, &i);
+		if(code > 0xFFFF) {
+			code -= 0x10000;
+			out[o++] = (uint16_t)(0xD800 | (code >> 10));
+			out[o++] = (uint16_t)(0xDC00 | (code & 0x3FF));
+		} else
+			out[o++] = (uint16_t)code;
+	}
+
+	return o;
+}
+
+size_t amd_utf16_utf8_length(const uint16_t *in, size_t length)
+{
+	size_t i = 0, bytes = 0;
+
+	while(i < length) {
+		size_t ascii;
+		uint16_t unit;
+
+		ascii = amd_utf16_ascii_length(in + i, length - i);
+		i += ascii;
+		bytes += ascii;
+		if(i >= length)
+			break;
+
+		unit = in[i++];
+		if(unit < 0x800)
+			bytes += 2;
+		else if(unit >= 0xD800 && unit <= 0xDBFF && i < length
+				&& in[i] >= 0xDC00 && in[i] <= 0xDFFF) {
+			bytes += 4;
+			++i;
+		} else
+			bytes += 3;
+	}
+
+	return bytes;
+}
+
+size_t amd_utf16_to_utf8(uint8_t *out, const uint16_t *in, size_t length)
+{
+	size_t i = 0, o = 0;
+
+	while(i < length) {
+		uint32_t code;
+
+#ifdef __SSE2__
+		// Narrow ASCII to 8 bits, 8 characters at a time
+		while(length - i >= 8) {
+			__m128i units = _mm_loadu_si128((const __m128i *)(in + i));
+
+			if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16((short)0xFF80)),
+												 _mm_setzero_si128())) != 0xFFFF)
+				break;
+
+			_mm_storel_epi64((__m128i *)(out + o), _mm_packus_epi16(units, units));
+			i += 8;
+			o += 8;
+		}
+		if(i >= length)
+			break;
+#endif
+
+		code = in[i++];
+		if(code < 0x80) {
+			out[o++] = (uint8_t)code;
+			continue;
+		}
+
+		if(code >= 0xD800 && code <= 0xDFFF) {
+			if(code <= 0xDBFF && i < length && in[i] >= 0xDC00 && in[i] <= 0xDFFF)
+				code = 0x10000 + ((code - 0xD800) << 10) + (in[i++] - 0xDC00);
+			else
+				code = AMD_UNICODE_REPLACEMENT;
+		}
+
+		if(code < 0x800) {
+			out[o++] = (uint8_t)(0xC0 | (code >> 6));
+			out[o++] = (uint8_t)(0x80 | (code & 0x3F));
+		} else if(code < 0x10000) {
+			out[o++] = (uint8_t)(0xE0 | (code >> 12));
+			out[o++] = (uint8_t)(0x80 | ((code >> 6) & 0x3F));
+			out[o++] = (uint8_t)(0x80 | (code & 0x3F));
+		} else {
+			out[o++] = (uint8_t)(0xF0 | (code >> 18));
+			out[o++] = (uint8_t)(0x80 | ((code >> 12) & 0x3F));
+			out[o++] = (uint8_t)(0x80 | ((code >> 6) & 0x3F));
+			out[o++] = (uint8_t)(0x80 | (code & 0x3F));
+		}
+	}
+
+	return o;
+}
+
+static inline uint32_t amd_utf8_next(const uint8_t *in, size_t length, size_t *position)
+{
+	size_t i = *position;
+	uint8_t lead, low = 0x80, high = 0xBF;
+	unsigned int needed;
+	uint32_t code;
+
+	lead = in[i++];
+	if(lead < 0x80) {
+		*position = i;
+		return lead;
+	} else if(lead >= 0xC2 && lead <= 0xDF) {
+		needed = 1;
+		code = lead & 0x1F;
+	} else if(lead >= 0xE0 && lead <= 0xEF) {
+		needed = 2;
+		code = lead & 0x0F;
+		// No overlong forms and no surrogates
+		if(lead == 0xE0)
+			low = 0xA0;
+		else if(lead == 0xED)
+			high = 0x9F;
+	} else if(lead >= 0xF0 && lead <= 0xF4) {
+		needed = 3;
+		code = lead & 0x07;
+		// No overlong forms and nothing above U+10FFFF
+		if(lead == 0xF0)
+			low = 0x90;
+		else if(lead == 0xF4)
+			high = 0x8F;
+	} else {
+		*position = i;
+		return AMD_UNICODE_REPLACEMENT;
+	}
+
+	while(needed > 0) {
+		if(i >= length || in[i] < low || in[i] > high) {
+			*position = i;
+			return AMD_UNICODE_REPLACEMENT;
+		}
+
+		code = code << 6 | (in[i++] & 0x3F);
+		low = 0x80;
+		high = 0xBF;
+		--needed;
+	}
+
+	*position = i;
+	return code;
+}
+
+static size_t amd_utf16_ascii_length(const uint16_t *in, size_t length)
+{
+	size_t i = 0;
+
+#ifdef __SSE2__
+	for(; length - i >= 8; i += 8) {
+		__m128i units = _mm_loadu_si128((const __m128i *)(in + i));
+
+		if(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16((short)0xFF80)),
+											 _mm_setzero_si128())) != 0xFFFF)
+			break;
+	}
+#endif
+
+	for(; i < length; ++i) {
+		if(in[i] >= 0x80)
+			break;
+	}
+
+	return i;
+}
@@ -23,7 +23,18 @@
  * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#import "AMDHeadlessRunner.h"
+
 int main(int argc, const char * argv[])
 {
+	if([AMDHeadlessRunner isHeadlessRunWithArgc:argc argv:argv]) {
+		@autoreleasepool {
+			AMDHeadlessRunner *runner;
+
+			runner = [[AMDHeadlessRunner alloc] initWithArguments:[[NSProcessInfo processInfo] arguments]];
+			return [runner run];
+		}
+	}
+
 	return NSApplicationMain(argc, argv);
 }
@@ -35,6 +35,14 @@
 #import "AMKSpriteSet.h"
 #import "AMKFont.h"
 #import "AMKWindowStyle.h"
+#import "AMKWindowRenderer.h"
 #import "AMKImage.h"
 #import "AMKTileSet.h"
-#import "AMKObstructionMap.h"
\ No newline at end of file
+#import "AMKTileAnimator.h"
+#import "AMKSpriteAnimator.h"
+#import "AMKGlyphAtlas.h"
+#import "AMKTextLayout.h"
+#import "AMKTextEngine.h"
+#import "AMKObstructionMap.h"
+#import "AMKResourceLoader.h"
+#import "AMKResourceCache.h"
\ No newline at end of file
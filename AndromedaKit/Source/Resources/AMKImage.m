@@ -250,4 +250,9 @@ NSImage *srk_nsimage_from_cgimage(CGImageRef imageRef, NSSize size)
 	return nil;
 }
 
+- (NSUInteger)memoryCost
+{
+	return _rawData.length;
+}
+
 @end
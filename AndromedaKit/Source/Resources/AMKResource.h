@@ -39,6 +39,15 @@
  */
 - (instancetype)initWithPath:(NSString *)path;
 
+@optional
+
+/**
+ * Estimate the memory used by the resource, for caching.
+ *
+ * @return Size in bytes.
+ */
+- (NSUInteger)memoryCost;
+
 @end
 
 /**
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKResource.h"
+
+/**
+ * @brief Statistics of a resource cache.
+ */
+typedef struct amk_resource_cache_statistics_s {
+	/// Requests served from the cache, including loads in progress.
+	NSUInteger hits;
+	/// Requests that loaded the resource.
+	NSUInteger misses;
+	/// Unreferenced resources removed to stay within the budget.
+	NSUInteger evictions;
+	/// Number of resources in the cache.
+	NSUInteger numberOfResources;
+	/// Estimated memory used by the resources in the cache, in bytes.
+	NSUInteger memoryUsage;
+} amk_resource_cache_statistics_t;
+
+/**
+ * @brief Process wide cache of loaded resources.
+ *
+ * Resources are keyed by their canonical path and class, so every
+ * user of the same file shares one object. A resource that is being
+ * loaded on one thread is waited for by other threads asking for it,
+ * instead of being loaded twice.
+ *
+ * Users retain a resource while they use it. Resources nobody retains
+ * stay in the cache until the memory used by the cache exceeds the
+ * budget, and are then evicted least recently used first. The memory
+ * of a resource is its -memoryCost, or the size of its file.
+ *
+ * Cached resources are shared: they must not be changed.
+ */
+@interface AMKResourceCache : NSObject
+
+/// Memory budget in bytes. Defaults to 128 MiB.
+@property (assign,nonatomic) NSUInteger memoryBudget;
+
+/// Current statistics.
+@property (readonly) amk_resource_cache_statistics_t statistics;
+
+/**
+ * Get the cache shared by the process.
+ *
+ * @return The shared cache.
+ */
++ (instancetype)sharedCache;
+
+/**
+ * Get a resource, loading it if it is not cached, and retain it.
+ *
+ * Every successful call must be balanced by -releaseResource:.
+ *
+ * @param resourceClass The class of the resource, conforming to AMKResource.
+ * @param path Path of the file.
+ * @return The resource, or nil if it could not be loaded.
+ */
+- (id)retainResourceOfClass:(Class)resourceClass atPath:(NSString *)path;
+
+/**
+ * Release a resource retained with -retainResourceOfClass:atPath:.
+ *
+ * @param resource The resource.
+ */
+- (void)releaseResource:(id)resource;
+
+/**
+ * Get a resource only if it is cached, without retaining it.
+ *
+ * @param resourceClass The class of the resource.
+ * @param path Path of the file.
+ * @return The resource, or nil if it is not cached.
+ */
+- (id)cachedResourceOfClass:(Class)resourceClass atPath:(NSString *)path;
+
+/**
+ * Remove the resources of a file, of any class.
+ *
+ * Users that retained them keep their objects, but new requests load
+ * the file again. Use when the file changed.
+ *
+ * @param path Path of the file.
+ */
+- (void)removeResourcesAtPath:(NSString *)path;
+
+/**
+ * Remove all resources.
+ */
+- (void)removeAllResources;
+
+/**
+ * Reset the hit, miss and eviction counts.
+ */
+- (void)resetStatistics;
+
+@end
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKResourceCache.h"
+
+#include <sys/stat.h>
+
+/**
+ * @brief An entry of the resource cache.
+ */
+@interface AMKResourceCacheEntry : NSObject
+@property (copy) NSString *key;
+@property (copy) NSString *path;
+@property (strong) id resource;
+@property (assign) NSUInteger referenceCount;
+@property (assign) NSUInteger memoryCost;
+/// Set while loading; waiters wait on it.
+@property (strong) dispatch_group_t loading;
+@end
+
+@implementation AMKResourceCacheEntry
+@end
+
+/**
+ * Get the estimated memory use of a resource.
+ *
+ * @param resource The resource.
+ * @param path Path of its file.
+ * @return Size in bytes.
+ */
+static NSUInteger amk_resource_memory_cost(id resource, NSString *path);
+
+@implementation AMKResourceCache {
+	NSMutableDictionary *_entries; // Key -> AMKResourceCacheEntry
+	NSMapTable *_entriesByResource; // Resource -> AMKResourceCacheEntry
+	NSMutableOrderedSet *_unreferenced; // Keys, least recently used first
+	amk_resource_cache_statistics_t _statistics;
+}
+
++ (instancetype)sharedCache
+{
+	static AMKResourceCache *sharedCache;
+	static dispatch_once_t onceToken;
+
+	dispatch_once(&onceToken, ^{
+		sharedCache = [[AMKResourceCache alloc] init];
+	});
+
+	return sharedCache;
+}
+
+- (instancetype)init
+{
+	self = [super init];
+	if(self) {
+		_entries = [[NSMutableDictionary alloc] init];
+		_entriesByResource = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory
+															  | NSPointerFunctionsObjectPointerPersonality
+												   valueOptions:NSPointerFunctionsStrongMemory];
+		_unreferenced = [[NSMutableOrderedSet alloc] init];
+		_memoryBudget = 128 * 1024 * 1024;
+	}
+	return self;
+}
+
+/**
+ * Get the key of a resource.
+ *
+ * @param resourceClass The class of the resource.
+ * @param path Canonical path of the file.
+ * @return The key.
+ */
+- (NSString *)keyForClass:(Class)resourceClass path:(NSString *)path
+{
+	return [NSString stringWithFormat:@"%@:%@",NSStringFromClass(resourceClass),path];
+}
+
+- (void)setMemoryBudget:(NSUInteger)memoryBudget
+{
+	@synchronized(self) {
+		_memoryBudget = memoryBudget;
+		[self evictIfNeeded];
+	}
+}
+
+- (amk_resource_cache_statistics_t)statistics
+{
+	@synchronized(self) {
+		_statistics.numberOfResources = _entriesByResource.count;
+		return _statistics;
+	}
+}
+
+- (void)resetStatistics
+{
+	@synchronized(self) {
+		_statistics.hits = 0;
+		_statistics.misses = 0;
+		_statistics.evictions = 0;
+	}
+}
+
+#pragma mark - Resources
+
+- (id)retainResourceOfClass:(Class)resourceClass atPath:(NSString *)path
+{
+	AMKResourceCacheEntry *entry;
+	dispatch_group_t loading;
+	NSString *key;
+	id resource;
+
+	path = [[path stringByResolvingSymlinksInPath] stringByStandardizingPath];
+	key = [self keyForClass:resourceClass path:path];
+
+	while(YES) {
+		@synchronized(self) {
+			entry = _entries[key];
+
+			if(entry != nil && entry.loading == nil) {
+				_statistics.hits++;
+				entry.referenceCount++;
+				[_unreferenced removeObject:key];
+				return entry.resource;
+			}
+
+			if(entry == nil) {
+				_statistics.misses++;
+
+				entry = [[AMKResourceCacheEntry alloc] init];
+				entry.key = key;
+				entry.path = path;
+				entry.loading = dispatch_group_create();
+				dispatch_group_enter(entry.loading);
+				_entries[key] = entry;
+				break;
+			}
+
+			// Loaded by another thread. Counted once, by the retry.
+			loading = entry.loading;
+		}
+
+		dispatch_group_wait(loading, DISPATCH_TIME_FOREVER);
+	}
+
+	// Load outside the lock: other resources can be used meanwhile
+	resource = [(id<AMKResource>)[resourceClass alloc] initWithPath:path];
+
+	@synchronized(self) {
+		loading = entry.loading;
+		entry.loading = nil;
+
+		if(resource == nil || _entries[key] != entry) {
+			// Failed, or removed while loading
+			if(_entries[key] == entry)
+				[_entries removeObjectForKey:key];
+		} else {
+			entry.resource = resource;
+			entry.referenceCount = 1;
+			entry.memoryCost = amk_resource_memory_cost(resource, path);
+
+			[_entriesByResource setObject:entry forKey:resource];
+			_statistics.memoryUsage += entry.memoryCost;
+			[self evictIfNeeded];
+		}
+	}
+
+	dispatch_group_leave(loading);
+
+	return resource;
+}
+
+- (void)releaseResource:(id)resource
+{
+	AMKResourceCacheEntry *entry;
+
+	if(resource == nil)
+		return;
+
+	@synchronized(self) {
+		entry = [_entriesByResource objectForKey:resource];
+		if(entry == nil || entry.referenceCount == 0)
+			return;
+
+		entry.referenceCount--;
+		if(entry.referenceCount == 0) {
+			[_unreferenced addObject:entry.key];
+			[self evictIfNeeded];
+		}
+	}
+}
+
+- (id)cachedResourceOfClass:(Class)resourceClass atPath:(NSString *)path
+{
+	AMKResourceCacheEntry *entry;
+	NSString *key;
+
+	path = [[path stringByResolvingSymlinksInPath] stringByStandardizingPath];
+	key = [self keyForClass:resourceClass path:path];
+
+	@synchronized(self) {
+		entry = _entries[key];
+		if(entry == nil || entry.loading != nil)
+			return nil;
+
+		// Most recently used
+		if([_unreferenced containsObject:key]) {
+			[_unreferenced removeObject:key];
+			[_unreferenced addObject:key];
+		}
+
+		return entry.resource;
+	}
+}
+
+- (void)removeResourcesAtPath:(NSString *)path
+{
+	path = [[path stringByResolvingSymlinksInPath] stringByStandardizingPath];
+
+	@synchronized(self) {
+		for(AMKResourceCacheEntry *entry in [_entries allValues]) {
+			if([entry.path isEqualToString:path])
+				[self removeEntry:entry];
+		}
+	}
+}
+
+- (void)removeAllResources
+{
+	@synchronized(self) {
+		for(AMKResourceCacheEntry *entry in [_entries allValues])
+			[self removeEntry:entry];
+	}
+}
+
+/**
+ * Remove an entry. Must be called with the lock held.
+ *
+ * @param entry The entry.
+ */
+- (void)removeEntry:(AMKResourceCacheEntry *)entry
+{
+	[_entries removeObjectForKey:entry.key];
+	[_unreferenced removeObject:entry.key];
+
+	// A load in progress finds its entry gone
+	if(entry.resource == nil)
+		return;
+
+	[_entriesByResource removeObjectForKey:entry.resource];
+	_statistics.memoryUsage -= entry.memoryCost;
+}
+
+/**
+ * Evict unreferenced resources until within budget. Must be called
+ * with the lock held.
+ */
+- (void)evictIfNeeded
+{
+	while(_statistics.memoryUsage > _memoryBudget && _unreferenced.count > 0) {
+		[self removeEntry:_entries[_unreferenced.firstObject]];
+		_statistics.evictions++;
+	}
+}
+
+@end
+
+static NSUInteger amk_resource_memory_cost(id resource, NSString *path)
+{
+	struct stat info;
+
+	if([resource respondsToSelector:@selector(memoryCost)])
+		return [resource memoryCost];
+
+	if(stat(path.fileSystemRepresentation, &info) != 0)
+		return 0;
+	return (NSUInteger)info.st_size;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKResource.h"
+
+/// Priority of a load. Higher priorities start first.
+typedef enum {
+	AMKResourceLoadPriorityLow = -4,
+	AMKResourceLoadPriorityNormal = 0,
+	AMKResourceLoadPriorityHigh = 4
+} AMKResourceLoadPriority;
+
+/**
+ * @brief A load in progress.
+ */
+@interface AMKResourceRequest : NSObject
+
+/// Path of the resource, or nil for a load with a block.
+@property (readonly) NSString *path;
+
+/// Priority of the load. Can be changed until the load starts.
+@property (assign,nonatomic) AMKResourceLoadPriority priority;
+
+/// Whether the load was cancelled.
+@property (readonly,getter=isCancelled) BOOL cancelled;
+
+/// Whether the completion handler was called.
+@property (readonly,getter=isFinished) BOOL finished;
+
+/**
+ * Cancel the load.
+ *
+ * The completion handler will not be called. A load that already
+ * started parsing runs to its end, but its result is thrown away.
+ */
+- (void)cancel;
+
+@end
+
+/**
+ * @brief Loads resources on a pool of background threads.
+ *
+ * Parsing a large resource, like a map with its tile set, takes
+ * long enough to drop frames when done on the thread that runs the
+ * game. The loader parses on background threads instead, and calls
+ * the completion handler on the main queue.
+ */
+@interface AMKResourceLoader : NSObject
+
+/// Maximum number of resources parsed at the same time. Defaults to
+/// the number of processors.
+@property (assign,nonatomic) NSUInteger maxConcurrentLoads;
+
+/**
+ * Get the loader shared by the engine.
+ *
+ * @return The shared loader.
+ */
++ (instancetype)sharedLoader;
+
+/**
+ * Get the class that loads a file, by its extension.
+ *
+ * @param path Path of the file.
+ * @return A class conforming to AMKResource, or nil if the file is
+ * not a known resource.
+ */
++ (Class)resourceClassForPath:(NSString *)path;
+
+/**
+ * Load a resource.
+ *
+ * Resources are loaded through the shared AMKResourceCache. The load
+ * holds a reference until the completion has returned, so retain the
+ * resource from the cache in the completion to keep using it. After
+ * that the resource stays cached without references, and may be
+ * evicted like any other. Files that are not a known resource are
+ * read as NSData.
+ *
+ * @param path Path of the file.
+ * @param priority Priority of the load.
+ * @param completion Called on the main queue with the resource, or nil
+ * on failure.
+ * @return The request.
+ */
+- (AMKResourceRequest *)loadResourceAtPath:(NSString *)path
+								  priority:(AMKResourceLoadPriority)priority
+								completion:(void (^)(id resource))completion;
+
+/**
+ * Run a load on the pool.
+ *
+ * @param priority Priority of the load.
+ * @param block Does the load and returns the result, on a background thread.
+ * @param completion Called on the main queue with the result of the block.
+ * @return The request.
+ */
+- (AMKResourceRequest *)loadWithPriority:(AMKResourceLoadPriority)priority
+								   block:(id (^)(void))block
+							  completion:(void (^)(id result))completion;
+
+/**
+ * Cancel all loads.
+ */
+- (void)cancelAllLoads;
+
+@end
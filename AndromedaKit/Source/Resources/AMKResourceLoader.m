@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKResourceLoader.h"
+#import "AMKResourceCache.h"
+#import "AMKImage.h"
+#import "AMKMap.h"
+#import "AMKSpriteSet.h"
+#import "AMKTileSet.h"
+#import "AMKFont.h"
+#import "AMKWindowStyle.h"
+#import "AMKFileSGM.h"
+
+@interface AMKResourceRequest ()
+- (instancetype)initWithPath:(NSString *)path operation:(NSOperation *)operation;
+- (BOOL)finish;
+@end
+
+@interface AMKResourceLoader ()
+- (AMKResourceRequest *)loadWithPath:(NSString *)path
+							priority:(AMKResourceLoadPriority)priority
+							   block:(id (^)(void))block
+						  completion:(void (^)(id result))completion
+							 cleanup:(void (^)(id result))cleanup;
+@end
+
+@implementation AMKResourceRequest {
+	// The queue keeps the operation until it finished, and the
+	// operation keeps the request.
+	__weak NSOperation *_operation;
+}
+
+- (instancetype)initWithPath:(NSString *)path operation:(NSOperation *)operation
+{
+	self = [super init];
+	if(self) {
+		_path = [path copy];
+		_operation = operation;
+		_priority = (AMKResourceLoadPriority)operation.queuePriority;
+	}
+	return self;
+}
+
+- (void)setPriority:(AMKResourceLoadPriority)priority
+{
+	_priority = priority;
+	@synchronized(self) {
+		_operation.queuePriority = (NSOperationQueuePriority)priority;
+	}
+}
+
+- (void)cancel
+{
+	NSOperation *operation;
+
+	@synchronized(self) {
+		_cancelled = YES;
+		operation = _operation;
+	}
+	[operation cancel];
+}
+
+/**
+ * Mark the request finished, on the main queue.
+ *
+ * @return YES if the completion handler must be called, NO if the
+ * request was cancelled.
+ */
+- (BOOL)finish
+{
+	@synchronized(self) {
+		if(_cancelled || _operation.isCancelled)
+			return NO;
+		_finished = YES;
+	}
+	return YES;
+}
+
+@end
+
+@implementation AMKResourceLoader {
+	NSOperationQueue *_queue;
+}
+
++ (instancetype)sharedLoader
+{
+	static AMKResourceLoader *sharedLoader;
+	static dispatch_once_t onceToken;
+
+	dispatch_once(&onceToken, ^{
+		sharedLoader = [[AMKResourceLoader alloc] init];
+	});
+
+	return sharedLoader;
+}
+
+- (instancetype)init
+{
+	self = [super init];
+	if(self) {
+		_queue = [[NSOperationQueue alloc] init];
+		_queue.name = @"AMKResourceLoader";
+		self.maxConcurrentLoads = [[NSProcessInfo processInfo] activeProcessorCount];
+	}
+	return self;
+}
+
+- (void)setMaxConcurrentLoads:(NSUInteger)maxConcurrentLoads
+{
+	_maxConcurrentLoads = MAX(maxConcurrentLoads, 1);
+	_queue.maxConcurrentOperationCount = _maxConcurrentLoads;
+}
+
++ (Class)resourceClassForPath:(NSString *)path
+{
+	static NSDictionary *classes;
+	static dispatch_once_t onceToken;
+
+	dispatch_once(&onceToken, ^{
+		classes = @{@"rmp" : [AMKMap class],
+					@"rss" : [AMKSpriteSet class],
+					@"rts" : [AMKTileSet class],
+					@"rfn" : [AMKFont class],
+					@"rws" : [AMKWindowStyle class],
+					@"sgm" : [AMKFileSGM class],
+					@"png" : [AMKImage class],
+					@"jpg" : [AMKImage class],
+					@"jpeg" : [AMKImage class],
+					@"gif" : [AMKImage class],
+					@"bmp" : [AMKImage class],
+					@"tiff" : [AMKImage class]};
+	});
+
+	return classes[[[path pathExtension] lowercaseString]];
+}
+
+- (AMKResourceRequest *)loadResourceAtPath:(NSString *)path
+								  priority:(AMKResourceLoadPriority)priority
+								completion:(void (^)(id resource))completion
+{
+	Class resourceClass = [[self class] resourceClassForPath:path];
+
+	path = [path copy];
+	return [self loadWithPath:path priority:priority block:^id{
+		AMKResourceCache *cache = [AMKResourceCache sharedCache];
+		id resource;
+
+		if(resourceClass == nil)
+			return [NSData dataWithContentsOfFile:path];
+
+		// Referenced until the completion has run, so the resource
+		// cannot be evicted before the caller gets to use it
+		resource = [cache retainResourceOfClass:resourceClass atPath:path];
+
+		return resource;
+	} completion:completion cleanup:^(id resource) {
+		if(resourceClass != nil)
+			[[AMKResourceCache sharedCache] releaseResource:resource];
+	}];
+}
+
+- (AMKResourceRequest *)loadWithPriority:(AMKResourceLoadPriority)priority
+								   block:(id (^)(void))block
+							  completion:(void (^)(id result))completion
+{
+	return [self loadWithPath:nil priority:priority block:block completion:completion cleanup:nil];
+}
+
+- (AMKResourceRequest *)loadWithPath:(NSString *)path
+							priority:(AMKResourceLoadPriority)priority
+							   block:(id (^)(void))block
+						  completion:(void (^)(id result))completion
+							 cleanup:(void (^)(id result))cleanup
+{
+	AMKResourceRequest *request;
+	NSBlockOperation *operation;
+	__weak NSBlockOperation *weakOperation;
+
+	operation = [[NSBlockOperation alloc] init];
+	operation.queuePriority = (NSOperationQueuePriority)priority;
+	weakOperation = operation;
+	request = [[AMKResourceRequest alloc] initWithPath:path operation:operation];
+
+	[operation addExecutionBlock:^{
+		id result;
+
+		if(weakOperation.isCancelled)
+			return;
+
+		@autoreleasepool {
+			result = block();
+		}
+
+		// Cleaned up even when cancelled meanwhile
+		dispatch_async(dispatch_get_main_queue(), ^{
+			if([request finish] && completion)
+				completion(result);
+			if(cleanup)
+				cleanup(result);
+		});
+	}];
+
+	[_queue addOperation:operation];
+
+	return request;
+}
+
+- (void)cancelAllLoads
+{
+	[_queue cancelAllOperations];
+}
+
+@end
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+
+@class AMKSpriteSet;
+
+/// Handle of a sprite in an AMKSpriteAnimator. 0 is never a valid handle.
+typedef uint32_t amk_sprite_handle_t;
+
+/// Handle that refers to no sprite.
+#define AMK_SPRITE_HANDLE_INVALID 0
+
+/**
+ * @brief Animates a pool of sprites.
+ *
+ * The state of every sprite (direction, frame and time left in the
+ * frame) is kept in parallel arrays, packed so that a tick walks over
+ * all active sprites in one pass without touching any objects. The
+ * frames of every sprite set are flattened into tables when the first
+ * sprite of the set is added.
+ *
+ * Sprites are referred to by handles. A handle contains a generation
+ * count, so handles of removed sprites stay invalid when their slot is
+ * reused.
+ */
+@interface AMKSpriteAnimator : NSObject
+
+/// Maximum number of sprites.
+@property (readonly) NSUInteger capacity;
+
+/// Number of sprites in the pool.
+@property (readonly) NSUInteger numberOfSprites;
+
+/// Number of entries in -changedSprites.
+@property (readonly) NSUInteger numberOfChangedSprites;
+
+/**
+ * Initialize with a maximum number of sprites.
+ *
+ * @param capacity Maximum number of sprites, at most 65535.
+ * @return self
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity;
+
+/**
+ * Add a sprite, playing the first frame of a direction.
+ *
+ * @param spriteSet The sprite set of the sprite.
+ * @param direction Index of the direction.
+ * @return Handle of the sprite, or AMK_SPRITE_HANDLE_INVALID if the
+ * pool is full or the direction does not exist.
+ */
+- (amk_sprite_handle_t)addSpriteWithSpriteSet:(AMKSpriteSet *)spriteSet
+									direction:(unsigned int)direction;
+
+/**
+ * Remove a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ */
+- (void)removeSprite:(amk_sprite_handle_t)sprite;
+
+/**
+ * Remove all sprites and forget all sprite sets.
+ */
+- (void)removeAllSprites;
+
+/**
+ * Find whether a handle refers to a sprite in the pool.
+ *
+ * @param sprite Handle of the sprite.
+ * @return YES if the sprite exists, NO otherwise.
+ */
+- (BOOL)containsSprite:(amk_sprite_handle_t)sprite;
+
+/**
+ * Change the direction of a sprite. Restarts at its first frame,
+ * unless the direction does not change.
+ *
+ * @param direction Index of the direction.
+ * @param sprite Handle of the sprite.
+ * @return YES on success, NO if the sprite or direction does not exist.
+ */
+- (BOOL)setDirection:(unsigned int)direction forSprite:(amk_sprite_handle_t)sprite;
+
+/**
+ * Pause or resume the animation of a sprite.
+ *
+ * @param playing YES to play, NO to pause.
+ * @param sprite Handle of the sprite.
+ */
+- (void)setPlaying:(BOOL)playing forSprite:(amk_sprite_handle_t)sprite;
+
+/**
+ * Get the direction of a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ * @return Index of the direction, or 0 if the sprite does not exist.
+ */
+- (unsigned int)directionOfSprite:(amk_sprite_handle_t)sprite;
+
+/**
+ * Get the current frame of a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ * @return Index of the frame in its direction, or 0 if the sprite does
+ * not exist.
+ */
+- (unsigned int)frameOfSprite:(amk_sprite_handle_t)sprite;
+
+/**
+ * Get the image shown by a sprite.
+ *
+ * @param sprite Handle of the sprite.
+ * @return Index of the image in the sprite set, or 0 if the sprite does
+ * not exist.
+ */
+- (unsigned int)imageOfSprite:(amk_sprite_handle_t)sprite;
+
+/**
+ * Advance the animation of all playing sprites.
+ *
+ * @param frames Number of frames to advance.
+ * @return The number of sprites that changed image.
+ */
+- (NSUInteger)advanceByFrames:(NSUInteger)frames;
+
+/**
+ * Sprites that changed image during the last advance.
+ *
+ * Valid until the next advance.
+ *
+ * @return A list of numberOfChangedSprites sprite handles.
+ */
+- (const amk_sprite_handle_t *)changedSprites NS_RETURNS_INNER_POINTER;
+
+@end
@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKSpriteAnimator.h"
+#import "AMKSpriteSet.h"
+
+/// Marks a slot that has no sprite.
+#define AMK_SPRITE_SLOT_FREE UINT16_MAX
+
+/// The flattened frames of a direction.
+typedef struct {
+	uint32_t firstFrame;
+	uint32_t numberOfFrames;
+	uint64_t totalDelay;	// 0 for directions that do not animate
+} amk_sprite_track_t;
+
+/// A sprite set with its directions in the track table.
+typedef struct {
+	uint32_t firstTrack;
+	uint32_t numberOfTracks;
+} amk_sprite_set_t;
+
+static BOOL amk_sprite_grow(void **array, uint32_t *capacity, uint32_t needed, size_t size);
+
+@implementation AMKSpriteAnimator {
+	// Sprite sets, and their frame tables
+	NSMapTable *_setIndices;
+	amk_sprite_set_t *_sets;
+	uint32_t _numberOfSets, _setCapacity;
+	amk_sprite_track_t *_tracks;
+	uint32_t _numberOfTracks, _trackCapacity;
+	uint16_t *_frameImages, *_frameDelays;
+	uint32_t _numberOfFrames, _frameCapacity;
+
+	// State of the sprites, packed in the first numberOfSprites entries
+	amk_sprite_handle_t *_handle;
+	uint32_t *_track;
+	uint16_t *_direction;
+	uint16_t *_frame;
+	uint32_t *_timeLeft;
+	uint8_t *_playing;
+
+	// Handle slots
+	uint16_t *_slotIndex;
+	uint16_t *_slotGeneration;
+	uint16_t *_freeSlots;
+	NSUInteger _numberOfFreeSlots;
+
+	amk_sprite_handle_t *_changedSprites;
+}
+
+- (instancetype)init
+{
+	return [self initWithCapacity:1024];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+	self = [super init];
+	if(self) {
+		_capacity = MIN(MAX(capacity, 1), UINT16_MAX);
+
+		_handle = calloc(_capacity, sizeof(amk_sprite_handle_t));
+		_track = calloc(_capacity, sizeof(uint32_t));
+		_direction = calloc(_capacity, sizeof(uint16_t));
+		_frame = calloc(_capacity, sizeof(uint16_t));
+		_timeLeft = calloc(_capacity, sizeof(uint32_t));
+		_playing = calloc(_capacity, sizeof(uint8_t));
+		_slotIndex = calloc(_capacity, sizeof(uint16_t));
+		_slotGeneration = calloc(_capacity, sizeof(uint16_t));
+		_freeSlots = calloc(_capacity, sizeof(uint16_t));
+		_changedSprites = calloc(_capacity, sizeof(amk_sprite_handle_t));
+
+		if(!_handle || !_track || !_direction || !_frame || !_timeLeft || !_playing
+		   || !_slotIndex || !_slotGeneration || !_freeSlots || !_changedSprites)
+			return nil;
+
+		_setIndices = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory
+														  | NSPointerFunctionsObjectPointerPersonality)
+											valueOptions:NSPointerFunctionsStrongMemory];
+
+		[self removeAllSprites];
+	}
+	return self;
+}
+
+- (void)dealloc
+{
+	free(_sets);
+	free(_tracks);
+	free(_frameImages);
+	free(_frameDelays);
+	free(_handle);
+	free(_track);
+	free(_direction);
+	free(_frame);
+	free(_timeLeft);
+	free(_playing);
+	free(_slotIndex);
+	free(_slotGeneration);
+	free(_freeSlots);
+	free(_changedSprites);
+}
+
+#pragma mark - Sprite sets
+
+/**
+ * Get the index of a sprite set in the set table, adding its
+ * directions and frames on first use.
+ *
+ * @param spriteSet The sprite set.
+ * @return Index of the set, or -1 on failure.
+ */
+- (NSInteger)indexOfSpriteSet:(AMKSpriteSet *)spriteSet
+{
+	NSNumber *index;
+	amk_sprite_set_t *set;
+	NSArray *directions;
+
+	if((index = [_setIndices objectForKey:spriteSet]) != nil)
+		return index.integerValue;
+
+	directions = spriteSet.directions;
+
+	if(!amk_sprite_grow((void **)&_sets, &_setCapacity, _numberOfSets + 1,
+						sizeof(amk_sprite_set_t))
+	   || !amk_sprite_grow((void **)&_tracks, &_trackCapacity,
+						   _numberOfTracks + (uint32_t)directions.count,
+						   sizeof(amk_sprite_track_t)))
+		return -1;
+
+	set = &_sets[_numberOfSets];
+	set->firstTrack = _numberOfTracks;
+	set->numberOfTracks = (uint32_t)directions.count;
+
+	for(AMKSpriteSetDirection *direction in directions) {
+		amk_sprite_track_t *track = &_tracks[_numberOfTracks++];
+		uint32_t needed = _numberOfFrames + (uint32_t)direction.frames.count;
+		uint32_t frameCapacity = _frameCapacity;
+
+		// Both frame arrays always have the same capacity
+		if(!amk_sprite_grow((void **)&_frameImages, &frameCapacity, needed, sizeof(uint16_t))
+		   || !amk_sprite_grow((void **)&_frameDelays, &_frameCapacity, needed, sizeof(uint16_t)))
+			return -1;
+
+		track->firstFrame = _numberOfFrames;
+		track->numberOfFrames = (uint32_t)direction.frames.count;
+		track->totalDelay = 0;
+
+		for(AMKSpriteSetFrame *frame in direction.frames) {
+			_frameImages[_numberOfFrames] = frame.index;
+			_frameDelays[_numberOfFrames] = MIN(frame.animationDelay, UINT16_MAX);
+			track->totalDelay += _frameDelays[_numberOfFrames];
+			_numberOfFrames++;
+		}
+
+		// One frame never changes
+		if(track->numberOfFrames < 2)
+			track->totalDelay = 0;
+	}
+
+	[_setIndices setObject:@(_numberOfSets) forKey:spriteSet];
+
+	return _numberOfSets++;
+}
+
+#pragma mark - Sprites
+
+/**
+ * Get the index of a sprite in the state arrays.
+ *
+ * @param sprite Handle of the sprite.
+ * @return Index of the sprite, or -1 if it does not exist.
+ */
+- (NSInteger)indexOfSprite:(amk_sprite_handle_t)sprite
+{
+	uint32_t slot = sprite & 0xFFFF, generation = sprite >> 16;
+
+	if(slot >= _capacity || _slotIndex[slot] == AMK_SPRITE_SLOT_FREE
+	   || _slotGeneration[slot] != generation)
+		return -1;
+
+	return _slotIndex[slot];
+}
+
+- (amk_sprite_handle_t)addSpriteWithSpriteSet:(AMKSpriteSet *)spriteSet
+									direction:(unsigned int)direction
+{
+	NSInteger setIndex;
+	amk_sprite_track_t *track;
+	NSUInteger index;
+	uint16_t slot;
+
+	if(_numberOfFreeSlots == 0 || spriteSet == nil)
+		return AMK_SPRITE_HANDLE_INVALID;
+
+	if((setIndex = [self indexOfSpriteSet:spriteSet]) < 0)
+		return AMK_SPRITE_HANDLE_INVALID;
+
+	if(direction >= _sets[setIndex].numberOfTracks)
+		return AMK_SPRITE_HANDLE_INVALID;
+
+	track = &_tracks[_sets[setIndex].firstTrack + direction];
+	if(track->numberOfFrames == 0)
+		return AMK_SPRITE_HANDLE_INVALID;
+
+	slot = _freeSlots[--_numberOfFreeSlots];
+	index = _numberOfSprites++;
+
+	_slotIndex[slot] = index;
+	_handle[index] = ((amk_sprite_handle_t)_slotGeneration[slot] << 16) | slot;
+	_track[index] = _sets[setIndex].firstTrack + direction;
+	_direction[index] = direction;
+	_frame[index] = 0;
+	_timeLeft[index] = _frameDelays[track->firstFrame];
+	_playing[index] = YES;
+
+	return _handle[index];
+}
+
+- (void)removeSprite:(amk_sprite_handle_t)sprite
+{
+	NSInteger index = [self indexOfSprite:sprite];
+	NSUInteger last;
+	uint16_t slot = sprite & 0xFFFF;
+
+	if(index < 0)
+		return;
+
+	// Move the last sprite into the hole, to keep the arrays packed
+	last = --_numberOfSprites;
+	if((NSUInteger)index != last) {
+		_handle[index] = _handle[last];
+		_track[index] = _track[last];
+		_direction[index] = _direction[last];
+		_frame[index] = _frame[last];
+		_timeLeft[index] = _timeLeft[last];
+		_playing[index] = _playing[last];
+		_slotIndex[_handle[index] & 0xFFFF] = index;
+	}
+
+	// Old handles of the slot become invalid
+	_slotIndex[slot] = AMK_SPRITE_SLOT_FREE;
+	if(++_slotGeneration[slot] == 0)
+		_slotGeneration[slot] = 1;
+	_freeSlots[_numberOfFreeSlots++] = slot;
+}
+
+- (void)removeAllSprites
+{
+	_numberOfSprites = 0;
+	_numberOfChangedSprites = 0;
+
+	// Slots are handed out from the end of the free list: lowest first
+	_numberOfFreeSlots = _capacity;
+	for(NSUInteger i = 0; i < _capacity; ++i) {
+		_freeSlots[i] = _capacity - 1 - i;
+		_slotIndex[i] = AMK_SPRITE_SLOT_FREE;
+		if(++_slotGeneration[i] == 0)
+			_slotGeneration[i] = 1;
+	}
+
+	[_setIndices removeAllObjects];
+	_numberOfSets = 0;
+	_numberOfTracks = 0;
+	_numberOfFrames = 0;
+}
+
+- (BOOL)containsSprite:(amk_sprite_handle_t)sprite
+{
+	return [self indexOfSprite:sprite] >= 0;
+}
+
+- (BOOL)setDirection:(unsigned int)direction forSprite:(amk_sprite_handle_t)sprite
+{
+	NSInteger index = [self indexOfSprite:sprite];
+	uint32_t firstTrack;
+	amk_sprite_track_t *track;
+
+	if(index < 0)
+		return NO;
+
+	if(_direction[index] == direction)
+		return YES;
+
+	// The tracks of a set are consecutive
+	firstTrack = _track[index] - _direction[index];
+	for(uint32_t i = 0; i < _numberOfSets; ++i) {
+		if(_sets[i].firstTrack != firstTrack)
+			continue;
+		if(direction >= _sets[i].numberOfTracks)
+			return NO;
+		break;
+	}
+
+	track = &_tracks[firstTrack + direction];
+	if(track->numberOfFrames == 0)
+		return NO;
+
+	_track[index] = firstTrack + direction;
+	_direction[index] = direction;
+	_frame[index] = 0;
+	_timeLeft[index] = _frameDelays[track->firstFrame];
+
+	return YES;
+}
+
+- (void)setPlaying:(BOOL)playing forSprite:(amk_sprite_handle_t)sprite
+{
+	NSInteger index = [self indexOfSprite:sprite];
+
+	if(index >= 0)
+		_playing[index] = playing;
+}
+
+- (unsigned int)directionOfSprite:(amk_sprite_handle_t)sprite
+{
+	NSInteger index = [self indexOfSprite:sprite];
+
+	return (index >= 0) ? _direction[index] : 0;
+}
+
+- (unsigned int)frameOfSprite:(amk_sprite_handle_t)sprite
+{
+	NSInteger index = [self indexOfSprite:sprite];
+
+	return (index >= 0) ? _frame[index] : 0;
+}
+
+- (unsigned int)imageOfSprite:(amk_sprite_handle_t)sprite
+{
+	NSInteger index = [self indexOfSprite:sprite];
+
+	if(index < 0)
+		return 0;
+	return _frameImages[_tracks[_track[index]].firstFrame + _frame[index]];
+}
+
+#pragma mark - Animating
+
+- (NSUInteger)advanceByFrames:(NSUInteger)frames
+{
+	_numberOfChangedSprites = 0;
+
+	for(NSUInteger i = 0; i < _numberOfSprites; ++i) {
+		const amk_sprite_track_t *track;
+		const uint16_t *delays, *images;
+		uint64_t remaining;
+		uint32_t frame;
+
+		if(!_playing[i])
+			continue;
+
+		if(frames < _timeLeft[i]) {
+			_timeLeft[i] -= frames;
+			continue;
+		}
+
+		track = &_tracks[_track[i]];
+		if(track->totalDelay == 0)
+			continue;
+
+		delays = _frameDelays + track->firstFrame;
+		images = _frameImages + track->firstFrame;
+
+		// Skip whole loops, then walk to the frame the time ends in
+		remaining = frames - _timeLeft[i];
+		if(remaining >= track->totalDelay)
+			remaining %= track->totalDelay;
+
+		frame = (_frame[i] + 1) % track->numberOfFrames;
+		while(remaining >= delays[frame]) {
+			remaining -= delays[frame];
+			frame = (frame + 1) % track->numberOfFrames;
+		}
+
+		if(images[frame] != images[_frame[i]])
+			_changedSprites[_numberOfChangedSprites++] = _handle[i];
+
+		_frame[i] = frame;
+		_timeLeft[i] = delays[frame] - (uint32_t)remaining;
+	}
+
+	return _numberOfChangedSprites;
+}
+
+- (const amk_sprite_handle_t *)changedSprites
+{
+	return _changedSprites;
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"<AMKSpriteAnimator>{sprites: %lu/%lu, sets: %u}",
+			(unsigned long)_numberOfSprites,(unsigned long)_capacity,_numberOfSets];
+}
+
+@end
+
+/**
+ * Make sure an array has room for a number of elements.
+ *
+ * @param array The array. Replaced when it grows.
+ * @param capacity Number of elements that fit. Updated when it grows.
+ * @param needed Number of elements needed.
+ * @param size Size of an element.
+ * @return YES on success, NO if out of memory.
+ */
+static BOOL amk_sprite_grow(void **array, uint32_t *capacity, uint32_t needed, size_t size)
+{
+	uint32_t newCapacity = MAX(*capacity, 16);
+	void *newArray;
+
+	if(needed <= *capacity && *array != NULL)
+		return YES;
+
+	while(newCapacity < needed)
+		newCapacity *= 2;
+
+	if((newArray = realloc(*array, newCapacity * size)) == NULL)
+		return NO;
+
+	*array = newArray;
+	*capacity = newCapacity;
+
+	return YES;
+}
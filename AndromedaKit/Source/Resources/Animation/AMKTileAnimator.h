@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+
+@class AMKTileSet;
+
+/**
+ * @brief Animates the tiles of a tile set.
+ *
+ * The nextTile/delay chains of all animated AMKTiles are resolved
+ * once, at creation. Every chain ends either in a still tile or in
+ * a cycle, and cycles are shared between all tiles that lead into
+ * them. After that, the animator keeps a single frame counter: the
+ * tile shown for an animated tile is looked up from the phase in its
+ * cycle. Only tiles whose next change is due are looked at in a tick.
+ *
+ * Renderers map the tile indices of a layer through -tileMap and
+ * invalidate their caches for the tiles in -changedTiles.
+ */
+@interface AMKTileAnimator : NSObject
+
+/// Number of tiles in the tile set.
+@property (readonly) NSUInteger numberOfTiles;
+
+/// Number of tiles that are animated.
+@property (readonly) NSUInteger numberOfAnimatedTiles;
+
+/// Frames advanced since creation or the last -reset.
+@property (readonly) uint64_t frame;
+
+/// Number of entries in -changedTiles.
+@property (readonly) NSUInteger numberOfChangedTiles;
+
+/**
+ * Initialize with the tiles of a tile set.
+ *
+ * @param tileSet The tile set.
+ * @return self
+ */
+- (instancetype)initWithTileSet:(AMKTileSet *)tileSet;
+
+/**
+ * Initialize with an array of tiles.
+ *
+ * @param tiles An array of AMKTiles.
+ * @return self
+ */
+- (instancetype)initWithTiles:(NSArray *)tiles;
+
+/**
+ * Advance the animation.
+ *
+ * @param frames Number of frames to advance.
+ * @return The number of tiles that changed image.
+ */
+- (NSUInteger)advanceByFrames:(NSUInteger)frames;
+
+/**
+ * Go back to the first frame. All tiles show themselves again.
+ */
+- (void)reset;
+
+/**
+ * Get the tile currently shown for a tile.
+ *
+ * @param tile Index of the tile in the tile set.
+ * @return Index of the tile to draw.
+ */
+- (unsigned int)currentTileForTile:(unsigned int)tile;
+
+/**
+ * Lookup table, indexed by tile, with the tile to draw.
+ *
+ * Valid until the animator is deallocated.
+ *
+ * @return A table of numberOfTiles entries.
+ */
+- (const uint16_t *)tileMap NS_RETURNS_INNER_POINTER;
+
+/**
+ * Tiles that changed image during the last advance.
+ *
+ * Valid until the next advance or reset.
+ *
+ * @return A list of numberOfChangedTiles tile indices.
+ */
+- (const uint16_t *)changedTiles NS_RETURNS_INNER_POINTER;
+
+@end
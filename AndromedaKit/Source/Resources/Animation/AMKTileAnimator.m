@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKTileAnimator.h"
+#import "AMKTileSet.h"
+
+/// A tile shown from a frame on, until the start of the next segment.
+typedef struct {
+	uint32_t start;
+	uint16_t tile;
+} amk_tile_segment_t;
+
+/// A resolved cycle: a run of segments that repeats.
+typedef struct {
+	uint32_t segment;
+	uint32_t count;
+	uint32_t frames;
+} amk_tile_cycle_t;
+
+/// The resolved animation of one animated tile.
+typedef struct {
+	uint16_t tile;			// The animated tile
+	uint16_t finalTile;		// Shown after the lead-in when there is no cycle
+	uint32_t prefix;		// First segment of the lead-in
+	uint32_t prefixCount;
+	uint32_t prefixFrames;
+	uint32_t cycle;			// First segment of the cycle
+	uint32_t cycleCount;	// 0 when the chain ends in a still tile
+	uint32_t cycleFrames;
+	uint32_t cyclePhase;	// Phase in the cycle at the end of the lead-in
+	uint64_t nextChange;	// Frame at which the shown tile must be looked up again
+} amk_tile_track_t;
+
+static uint32_t amk_tile_segment_search(const amk_tile_segment_t *segments,
+										uint32_t count,
+										uint32_t phase);
+static uint16_t amk_tile_track_tile_at_frame(const amk_tile_track_t *track,
+											 const amk_tile_segment_t *segments,
+											 uint64_t frame,
+											 uint64_t *nextChange);
+
+@implementation AMKTileAnimator {
+	uint16_t *_tileMap;
+	uint16_t *_changedTiles;
+	amk_tile_track_t *_tracks;
+	amk_tile_segment_t *_segments;
+	uint32_t _numberOfSegments;
+}
+
+- (instancetype)initWithTileSet:(AMKTileSet *)tileSet
+{
+	return [self initWithTiles:tileSet.tiles];
+}
+
+- (instancetype)initWithTiles:(NSArray *)tiles
+{
+	self = [super init];
+	if(self) {
+		_numberOfTiles = tiles.count;
+
+		_tileMap = calloc(MAX(_numberOfTiles, 1), sizeof(uint16_t));
+		if(_tileMap == NULL)
+			return nil;
+
+		if(![self resolveTiles:tiles])
+			return nil;
+
+		[self reset];
+	}
+	return self;
+}
+
+- (void)dealloc
+{
+	free(_tileMap);
+	free(_changedTiles);
+	free(_tracks);
+	free(_segments);
+}
+
+#pragma mark - Resolving
+
+- (BOOL)appendSegmentWithTile:(uint16_t)tile start:(uint32_t)start
+{
+	amk_tile_segment_t *segments;
+
+	// Grow whenever the count reaches a power of two
+	if((_numberOfSegments & (_numberOfSegments - 1)) == 0) {
+		segments = realloc(_segments, MAX(_numberOfSegments * 2, 8) * sizeof(amk_tile_segment_t));
+		if(segments == NULL)
+			return NO;
+		_segments = segments;
+	}
+
+	_segments[_numberOfSegments].start = start;
+	_segments[_numberOfSegments].tile = tile;
+	_numberOfSegments++;
+
+	return YES;
+}
+
+- (BOOL)resolveTiles:(NSArray *)tiles
+{
+	NSUInteger count = _numberOfTiles;
+	uint16_t *next, *delay;
+	BOOL *animated;
+	uint32_t *seenStamp, *seenIndex, *walkStart, *phaseOf;
+	uint16_t *walkTile;
+	int32_t *cycleOf;
+	amk_tile_cycle_t *cycles;
+	uint32_t numberOfCycles = 0;
+	BOOL success = NO;
+
+	next = calloc(count, sizeof(uint16_t));
+	delay = calloc(count, sizeof(uint16_t));
+	animated = calloc(count, sizeof(BOOL));
+	seenStamp = calloc(count, sizeof(uint32_t));
+	seenIndex = calloc(count, sizeof(uint32_t));
+	walkStart = calloc(count, sizeof(uint32_t));
+	walkTile = calloc(count, sizeof(uint16_t));
+	phaseOf = calloc(count, sizeof(uint32_t));
+	cycleOf = malloc(count * sizeof(int32_t));
+	cycles = calloc(count, sizeof(amk_tile_cycle_t));
+
+	if(count > 0 && (!next || !delay || !animated || !seenStamp || !seenIndex
+	   || !walkStart || !walkTile || !phaseOf || !cycleOf || !cycles))
+		goto out;
+
+	// Copy the chains out of the tile objects
+	_numberOfAnimatedTiles = 0;
+	for(NSUInteger i = 0; i < count; ++i) {
+		AMKTile *tile = tiles[i];
+
+		cycleOf[i] = -1;
+
+		// A tile without delay or a valid next tile is a still tile
+		if(!tile.animated || tile.delay <= 0 || tile.nextTile < 0
+		   || (NSUInteger)tile.nextTile >= count)
+			continue;
+
+		animated[i] = YES;
+		next[i] = tile.nextTile;
+		delay[i] = MIN(tile.delay, UINT16_MAX);
+		_numberOfAnimatedTiles++;
+	}
+
+	_tracks = calloc(MAX(_numberOfAnimatedTiles, 1), sizeof(amk_tile_track_t));
+	_changedTiles = calloc(MAX(_numberOfAnimatedTiles, 1), sizeof(uint16_t));
+	if(_tracks == NULL || _changedTiles == NULL)
+		goto out;
+
+	// Walk the chain of every animated tile until it ends in a still tile,
+	// runs into itself (a new cycle) or into a cycle found earlier.
+	for(uint32_t s = 0, t = 0; s < count; ++s) {
+		amk_tile_track_t *track;
+		uint32_t cur = s, pos = 0, n = 0, prefixCount;
+
+		if(!animated[s])
+			continue;
+
+		track = &_tracks[t++];
+		track->tile = s;
+
+		while(animated[cur] && cycleOf[cur] < 0 && seenStamp[cur] != s + 1) {
+			seenStamp[cur] = s + 1;
+			seenIndex[cur] = n;
+			walkTile[n] = cur;
+			walkStart[n] = pos;
+			n++;
+
+			pos += delay[cur];
+			cur = next[cur];
+		}
+
+		prefixCount = n;
+
+		if(animated[cur] && cycleOf[cur] < 0) {
+			amk_tile_cycle_t *cycle;
+			uint32_t k = seenIndex[cur];
+
+			// New cycle, from walk[k] up to the end of the walk
+			cycle = &cycles[numberOfCycles];
+			cycle->segment = _numberOfSegments;
+			cycle->count = n - k;
+			cycle->frames = pos - walkStart[k];
+
+			for(uint32_t i = k; i < n; ++i) {
+				if(![self appendSegmentWithTile:walkTile[i] start:walkStart[i] - walkStart[k]])
+					goto out;
+				cycleOf[walkTile[i]] = numberOfCycles;
+				phaseOf[walkTile[i]] = walkStart[i] - walkStart[k];
+			}
+
+			numberOfCycles++;
+			prefixCount = k;
+		}
+
+		// The lead-in into the cycle or still tile
+		track->prefix = _numberOfSegments;
+		track->prefixCount = prefixCount;
+		track->prefixFrames = (prefixCount < n) ? walkStart[prefixCount] : pos;
+		for(uint32_t i = 0; i < prefixCount; ++i) {
+			if(![self appendSegmentWithTile:walkTile[i] start:walkStart[i]])
+				goto out;
+		}
+
+		if(animated[cur]) {
+			amk_tile_cycle_t *cycle = &cycles[cycleOf[cur]];
+
+			track->cycle = cycle->segment;
+			track->cycleCount = cycle->count;
+			track->cycleFrames = cycle->frames;
+			track->cyclePhase = phaseOf[cur];
+		} else
+			track->finalTile = cur;
+	}
+
+	success = YES;
+
+out:
+	free(next);
+	free(delay);
+	free(animated);
+	free(seenStamp);
+	free(seenIndex);
+	free(walkStart);
+	free(walkTile);
+	free(phaseOf);
+	free(cycleOf);
+	free(cycles);
+
+	return success;
+}
+
+#pragma mark - Animating
+
+- (NSUInteger)advanceByFrames:(NSUInteger)frames
+{
+	_frame += frames;
+	_numberOfChangedTiles = 0;
+
+	for(NSUInteger i = 0; i < _numberOfAnimatedTiles; ++i) {
+		amk_tile_track_t *track = &_tracks[i];
+		uint16_t tile;
+
+		if(_frame < track->nextChange)
+			continue;
+
+		tile = amk_tile_track_tile_at_frame(track, _segments, _frame, &track->nextChange);
+		if(tile != _tileMap[track->tile]) {
+			_tileMap[track->tile] = tile;
+			_changedTiles[_numberOfChangedTiles++] = track->tile;
+		}
+	}
+
+	return _numberOfChangedTiles;
+}
+
+- (void)reset
+{
+	_frame = 0;
+	_numberOfChangedTiles = 0;
+
+	for(NSUInteger i = 0; i < _numberOfTiles; ++i)
+		_tileMap[i] = i;
+
+	for(NSUInteger i = 0; i < _numberOfAnimatedTiles; ++i) {
+		amk_tile_track_t *track = &_tracks[i];
+
+		_tileMap[track->tile] = amk_tile_track_tile_at_frame(track, _segments, 0,
+															 &track->nextChange);
+	}
+}
+
+- (unsigned int)currentTileForTile:(unsigned int)tile
+{
+	if(tile >= _numberOfTiles)
+		return tile;
+	return _tileMap[tile];
+}
+
+- (const uint16_t *)tileMap
+{
+	return _tileMap;
+}
+
+- (const uint16_t *)changedTiles
+{
+	return _changedTiles;
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"<AMKTileAnimator>{tiles: %lu, animated: %lu, "
+			@"segments: %u, frame: %llu}",(unsigned long)_numberOfTiles,
+			(unsigned long)_numberOfAnimatedTiles,_numberOfSegments,_frame];
+}
+
+@end
+
+/**
+ * Find the segment that contains a phase.
+ *
+ * @param segments Segments, ordered by start. The first starts at 0.
+ * @param count Number of segments.
+ * @param phase The phase.
+ * @return Index of the last segment starting at or before the phase.
+ */
+static uint32_t amk_tile_segment_search(const amk_tile_segment_t *segments,
+										uint32_t count,
+										uint32_t phase)
+{
+	uint32_t low = 0, high = count;
+
+	while(high - low > 1) {
+		uint32_t mid = low + (high - low) / 2;
+
+		if(segments[mid].start <= phase)
+			low = mid;
+		else
+			high = mid;
+	}
+
+	return low;
+}
+
+/**
+ * Get the tile shown by a track at a frame.
+ *
+ * @param track The track.
+ * @param segments All segments.
+ * @param frame The frame.
+ * @param nextChange Set to the first frame a different tile may be shown.
+ * @return The tile to show.
+ */
+static uint16_t amk_tile_track_tile_at_frame(const amk_tile_track_t *track,
+											 const amk_tile_segment_t *segments,
+											 uint64_t frame,
+											 uint64_t *nextChange)
+{
+	const amk_tile_segment_t *segs;
+	uint32_t phase, i, end;
+
+	if(frame < track->prefixFrames) {
+		segs = segments + track->prefix;
+		i = amk_tile_segment_search(segs, track->prefixCount, (uint32_t)frame);
+		end = (i + 1 < track->prefixCount) ? segs[i + 1].start : track->prefixFrames;
+
+		*nextChange = end;
+		return segs[i].tile;
+	}
+
+	if(track->cycleCount == 0) {
+		*nextChange = UINT64_MAX;
+		return track->finalTile;
+	}
+
+	segs = segments + track->cycle;
+	phase = (frame - track->prefixFrames + track->cyclePhase) % track->cycleFrames;
+	i = amk_tile_segment_search(segs, track->cycleCount, phase);
+	end = (i + 1 < track->cycleCount) ? segs[i + 1].start : track->cycleFrames;
+
+	*nextChange = frame + (end - phase);
+	return segs[i].tile;
+}
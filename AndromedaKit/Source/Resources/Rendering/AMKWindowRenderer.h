@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+@class AMKImage, AMKWindowStyle;
+
+/**
+ * @brief Renders window styles into images of any size.
+ *
+ * The nine images of a style are laid out around the inner area:
+ * corners in the corners, edges tiled along the sides and the
+ * background in the middle, extended under the edges by the edge
+ * offsets. All background modes are supported; the gradient modes
+ * blend the four corner colors over the background.
+ *
+ * Rendered windows are cached by style and size, least recently used
+ * first out. Menus draw the same windows every frame, and those are
+ * then only rendered once.
+ */
+@interface AMKWindowRenderer : NSObject
+
+/// Maximum number of windows kept in the cache. Defaults to 32.
+@property (assign,nonatomic) NSUInteger cacheLimit;
+
+/// Number of windows currently in the cache.
+@property (readonly) NSUInteger numberOfCachedWindows;
+
+/**
+ * Get the rendered window for a style.
+ *
+ * The image includes the edges, so it is larger than the inner size.
+ *
+ * @param style The window style.
+ * @param size Size of the inner area of the window.
+ * @return The window image, possibly from the cache, or nil on failure.
+ */
+- (AMKImage *)imageForWindowStyle:(AMKWindowStyle *)style innerSize:(NSSize)size;
+
+/**
+ * Remove all windows of a style from the cache.
+ *
+ * Must be called after changing the style.
+ *
+ * @param style The window style.
+ */
+- (void)removeCachedWindowsForStyle:(AMKWindowStyle *)style;
+
+/**
+ * Remove all windows from the cache.
+ */
+- (void)removeAllCachedWindows;
+
+/**
+ * Render a window, without using the cache.
+ *
+ * @param style The window style.
+ * @param size Size of the inner area of the window.
+ * @param frameSize Set to the size of the rendered window.
+ * @return RGBA pixels of the window.
+ */
++ (NSData *)renderWindowStyle:(AMKWindowStyle *)style
+					innerSize:(NSSize)size
+					frameSize:(NSSize *)frameSize;
+
+@end
@@ -0,0 +1,473 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKWindowRenderer.h"
+#import "AMKWindowStyle.h"
+#import "AMKImage.h"
+
+typedef float amk_float4 __attribute__((ext_vector_type(4)));
+typedef uint8_t amk_uchar4 __attribute__((ext_vector_type(4)));
+
+/// A bitmap of RGBA pixels.
+typedef struct {
+	srk_rgba_t *pixels;
+	long width, height;
+} amk_bitmap_t;
+
+/// A rectangle in a bitmap, from x0,y0 up to, not including, x1,y1.
+typedef struct {
+	long x0, y0, x1, y1;
+} amk_rect_t;
+
+static amk_bitmap_t amk_bitmap_from_image(AMKImage *image);
+static void amk_bitmap_tile(amk_bitmap_t *dest, amk_bitmap_t src, amk_rect_t rect);
+static void amk_bitmap_stretch(amk_bitmap_t *dest, amk_bitmap_t src, amk_rect_t rect);
+static void amk_bitmap_blit(amk_bitmap_t *dest, amk_bitmap_t src, long x, long y);
+static void amk_bitmap_gradient(amk_bitmap_t *dest, const srk_rgba_t colors[4],
+								amk_rect_t rect, BOOL blend);
+
+/**
+ * @brief Key of the window cache.
+ */
+@interface AMKWindowCacheKey : NSObject <NSCopying>
+@property (readonly) AMKWindowStyle *style;
+@property (readonly) NSSize size;
+- (instancetype)initWithStyle:(AMKWindowStyle *)style size:(NSSize)size;
+@end
+
+@implementation AMKWindowCacheKey
+
+- (instancetype)initWithStyle:(AMKWindowStyle *)style size:(NSSize)size
+{
+	self = [super init];
+	if(self) {
+		_style = style;
+		_size = size;
+	}
+	return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return self;
+}
+
+- (NSUInteger)hash
+{
+	return (NSUInteger)_style ^ ((NSUInteger)_size.width << 16) ^ (NSUInteger)_size.height;
+}
+
+- (BOOL)isEqual:(id)object
+{
+	AMKWindowCacheKey *other = object;
+
+	if(![object isKindOfClass:[AMKWindowCacheKey class]])
+		return NO;
+	return other.style == _style && NSEqualSizes(other.size, _size);
+}
+
+@end
+
+@implementation AMKWindowRenderer {
+	NSMutableDictionary *_cache;
+	NSMutableArray *_cacheOrder; // Least recently used first
+}
+
+- (instancetype)init
+{
+	self = [super init];
+	if(self) {
+		_cache = [[NSMutableDictionary alloc] init];
+		_cacheOrder = [[NSMutableArray alloc] init];
+		_cacheLimit = 32;
+	}
+	return self;
+}
+
+#pragma mark - Cache
+
+- (void)setCacheLimit:(NSUInteger)cacheLimit
+{
+	@synchronized(self) {
+		_cacheLimit = cacheLimit;
+		[self evictWindows];
+	}
+}
+
+- (NSUInteger)numberOfCachedWindows
+{
+	@synchronized(self) {
+		return _cache.count;
+	}
+}
+
+- (void)evictWindows
+{
+	while(_cacheOrder.count > _cacheLimit) {
+		[_cache removeObjectForKey:_cacheOrder[0]];
+		[_cacheOrder removeObjectAtIndex:0];
+	}
+}
+
+- (AMKImage *)imageForWindowStyle:(AMKWindowStyle *)style innerSize:(NSSize)size
+{
+	AMKWindowCacheKey *key;
+	AMKImage *image;
+	NSData *pixels;
+	NSSize frameSize;
+
+	if(style == nil)
+		return nil;
+
+	size = NSMakeSize(MAX(floor(size.width), 0), MAX(floor(size.height), 0));
+	key = [[AMKWindowCacheKey alloc] initWithStyle:style size:size];
+
+	@synchronized(self) {
+		image = _cache[key];
+		if(image != nil) {
+			// Most recently used goes to the back
+			[_cacheOrder removeObject:key];
+			[_cacheOrder addObject:key];
+			return image;
+		}
+	}
+
+	pixels = [AMKWindowRenderer renderWindowStyle:style
+										innerSize:size
+										frameSize:&frameSize];
+	if(pixels == nil || pixels.length == 0)
+		return nil;
+
+	image = [[AMKImage alloc] initWithRawBitmapData:pixels
+											   size:frameSize
+											 format:AMKImageFormatRGBA];
+	if(image == nil || _cacheLimit == 0)
+		return image;
+
+	@synchronized(self) {
+		if(_cache[key] == nil)
+			[_cacheOrder addObject:key];
+		_cache[key] = image;
+		[self evictWindows];
+	}
+
+	return image;
+}
+
+- (void)removeCachedWindowsForStyle:(AMKWindowStyle *)style
+{
+	@synchronized(self) {
+		for(AMKWindowCacheKey *key in [_cacheOrder copy]) {
+			if(key.style != style)
+				continue;
+			[_cache removeObjectForKey:key];
+			[_cacheOrder removeObject:key];
+		}
+	}
+}
+
+- (void)removeAllCachedWindows
+{
+	@synchronized(self) {
+		[_cache removeAllObjects];
+		[_cacheOrder removeAllObjects];
+	}
+}
+
+#pragma mark - Rendering
+
++ (NSData *)renderWindowStyle:(AMKWindowStyle *)style
+					innerSize:(NSSize)size
+					frameSize:(NSSize *)frameSize
+{
+	amk_bitmap_t images[9], frame;
+	srk_rgba_t colors[4];
+	NSMutableData *data;
+	amk_rect_t background, edge;
+	long width, height, left, top, right, bottom;
+
+	for(int i = 0; i < 9; i++)
+		images[i] = amk_bitmap_from_image([style getImage:i]);
+
+	for(int i = 0; i < 4; i++) {
+		NSColor *color;
+
+		color = [[style getBackgroundColorForCorner:i]
+				 colorUsingColorSpaceName:NSCalibratedRGBColorSpace];
+		colors[i] = (srk_rgba_t){
+			color.redComponent * 255,
+			color.greenComponent * 255,
+			color.blueComponent * 255,
+			color.alphaComponent * 255
+		};
+	}
+
+	width = MAX(size.width, 0);
+	height = MAX(size.height, 0);
+	left = images[AMKWindowStyleImageLeft].width;
+	right = images[AMKWindowStyleImageRight].width;
+	top = images[AMKWindowStyleImageTop].height;
+	bottom = images[AMKWindowStyleImageBottom].height;
+
+	frame.width = left + width + right;
+	frame.height = top + height + bottom;
+	if(frameSize)
+		*frameSize = NSMakeSize(frame.width, frame.height);
+
+	data = [NSMutableData dataWithLength:frame.width * frame.height * sizeof(srk_rgba_t)];
+	if(data.length == 0)
+		return data;
+	frame.pixels = data.mutableBytes;
+
+	// The background reaches under the edges by their offsets
+	background.x0 = MAX(left - [style getOffsetForEdge:AMKWindowStyleEdgeLeft], 0);
+	background.y0 = MAX(top - [style getOffsetForEdge:AMKWindowStyleEdgeTop], 0);
+	background.x1 = MIN(left + width + [style getOffsetForEdge:AMKWindowStyleEdgeRight], frame.width);
+	background.y1 = MIN(top + height + [style getOffsetForEdge:AMKWindowStyleEdgeBottom], frame.height);
+
+	switch(style.backgroundMode) {
+		case AMKWindowStyleModeTiled:
+			amk_bitmap_tile(&frame, images[AMKWindowStyleImageBackground], background);
+			break;
+		case AMKWindowStyleModeStretched:
+			amk_bitmap_stretch(&frame, images[AMKWindowStyleImageBackground], background);
+			break;
+		case AMKWindowStyleModeGradient:
+			amk_bitmap_gradient(&frame, colors, background, NO);
+			break;
+		case AMKWindowStyleModeTiledGradient:
+			amk_bitmap_tile(&frame, images[AMKWindowStyleImageBackground], background);
+			amk_bitmap_gradient(&frame, colors, background, YES);
+			break;
+		case AMKWindowStyleModeStretchedGradient:
+			amk_bitmap_stretch(&frame, images[AMKWindowStyleImageBackground], background);
+			amk_bitmap_gradient(&frame, colors, background, YES);
+			break;
+	}
+
+	// Edges
+	edge = (amk_rect_t){left, 0, left + width, top};
+	amk_bitmap_tile(&frame, images[AMKWindowStyleImageTop], edge);
+	edge = (amk_rect_t){left, top + height, left + width, frame.height};
+	amk_bitmap_tile(&frame, images[AMKWindowStyleImageBottom], edge);
+	edge = (amk_rect_t){0, top, left, top + height};
+	amk_bitmap_tile(&frame, images[AMKWindowStyleImageLeft], edge);
+	edge = (amk_rect_t){left + width, top, frame.width, top + height};
+	amk_bitmap_tile(&frame, images[AMKWindowStyleImageRight], edge);
+
+	// Corners
+	amk_bitmap_blit(&frame, images[AMKWindowStyleImageUpperLeft], 0, 0);
+	amk_bitmap_blit(&frame, images[AMKWindowStyleImageUpperRight],
+					frame.width - images[AMKWindowStyleImageUpperRight].width, 0);
+	amk_bitmap_blit(&frame, images[AMKWindowStyleImageLowerLeft],
+					0, frame.height - images[AMKWindowStyleImageLowerLeft].height);
+	amk_bitmap_blit(&frame, images[AMKWindowStyleImageLowerRight],
+					frame.width - images[AMKWindowStyleImageLowerRight].width,
+					frame.height - images[AMKWindowStyleImageLowerRight].height);
+
+	return data;
+}
+
+@end
+
+#pragma mark - Bitmap functions
+
+/**
+ * Get the pixels of an image.
+ *
+ * @param image The image.
+ * @return A bitmap referring to the pixels of the image, or an empty
+ * bitmap if the image has no RGBA data.
+ */
+static amk_bitmap_t amk_bitmap_from_image(AMKImage *image)
+{
+	amk_bitmap_t bitmap = {NULL, 0, 0};
+	long width = image.rawSize.width, height = image.rawSize.height;
+
+	if(image.format != AMKImageFormatRGBA
+	   || image.rawData.length < width * height * sizeof(srk_rgba_t))
+		return bitmap;
+
+	bitmap.pixels = (srk_rgba_t *)image.rawData.bytes;
+	bitmap.width = width;
+	bitmap.height = height;
+
+	return bitmap;
+}
+
+/**
+ * Draw a pixel over another.
+ *
+ * @param dest The pixel to draw on.
+ * @param src The pixel to draw.
+ */
+static inline void amk_pixel_blend(srk_rgba_t *dest, srk_rgba_t src)
+{
+	unsigned int alpha = src.alpha, inverse = 255 - src.alpha;
+
+	if(alpha == 255)
+		*dest = src;
+	else if(alpha != 0) {
+		dest->red = (src.red * alpha + dest->red * inverse) / 255;
+		dest->green = (src.green * alpha + dest->green * inverse) / 255;
+		dest->blue = (src.blue * alpha + dest->blue * inverse) / 255;
+		dest->alpha = alpha + dest->alpha * inverse / 255;
+	}
+}
+
+/**
+ * Draw part of a bitmap, clipped to a rectangle.
+ *
+ * @param dest The bitmap to draw on.
+ * @param src The bitmap to draw.
+ * @param x Where to draw the left side of src.
+ * @param y Where to draw the top side of src.
+ * @param clip Rectangle in dest to draw in.
+ */
+static void amk_bitmap_draw(amk_bitmap_t *dest, amk_bitmap_t src, long x, long y, amk_rect_t clip)
+{
+	long x0 = MAX(x, MAX(clip.x0, 0)), x1 = MIN(x + src.width, MIN(clip.x1, dest->width));
+	long y0 = MAX(y, MAX(clip.y0, 0)), y1 = MIN(y + src.height, MIN(clip.y1, dest->height));
+
+	for(long dy = y0; dy < y1; ++dy) {
+		srk_rgba_t *destRow = dest->pixels + dy * dest->width;
+		const srk_rgba_t *srcRow = src.pixels + (dy - y) * src.width - x;
+
+		for(long dx = x0; dx < x1; ++dx)
+			amk_pixel_blend(&destRow[dx], srcRow[dx]);
+	}
+}
+
+/**
+ * Draw a bitmap.
+ *
+ * @param dest The bitmap to draw on.
+ * @param src The bitmap to draw.
+ * @param x Where to draw the left side of src.
+ * @param y Where to draw the top side of src.
+ */
+static void amk_bitmap_blit(amk_bitmap_t *dest, amk_bitmap_t src, long x, long y)
+{
+	amk_bitmap_draw(dest, src, x, y, (amk_rect_t){0, 0, dest->width, dest->height});
+}
+
+/**
+ * Fill a rectangle with copies of a bitmap, starting at its top-left.
+ *
+ * @param dest The bitmap to draw on.
+ * @param src The bitmap to repeat.
+ * @param rect The rectangle to fill.
+ */
+static void amk_bitmap_tile(amk_bitmap_t *dest, amk_bitmap_t src, amk_rect_t rect)
+{
+	if(src.width == 0 || src.height == 0)
+		return;
+
+	for(long y = rect.y0; y < rect.y1; y += src.height) {
+		for(long x = rect.x0; x < rect.x1; x += src.width)
+			amk_bitmap_draw(dest, src, x, y, rect);
+	}
+}
+
+/**
+ * Scale a bitmap to fill a rectangle, without filtering.
+ *
+ * @param dest The bitmap to draw on.
+ * @param src The bitmap to scale.
+ * @param rect The rectangle to fill.
+ */
+static void amk_bitmap_stretch(amk_bitmap_t *dest, amk_bitmap_t src, amk_rect_t rect)
+{
+	long width = rect.x1 - rect.x0, height = rect.y1 - rect.y0;
+
+	if(src.width == 0 || src.height == 0 || width <= 0 || height <= 0)
+		return;
+
+	for(long y = 0; y < height; ++y) {
+		srk_rgba_t *destRow = dest->pixels + (rect.y0 + y) * dest->width + rect.x0;
+		const srk_rgba_t *srcRow = src.pixels + (y * src.height / height) * src.width;
+
+		for(long x = 0; x < width; ++x)
+			amk_pixel_blend(&destRow[x], srcRow[x * src.width / width]);
+	}
+}
+
+static inline amk_float4 amk_float4_from_rgba(srk_rgba_t color)
+{
+	return (amk_float4){color.red, color.green, color.blue, color.alpha};
+}
+
+/**
+ * Fill a rectangle with a gradient between four corner colors.
+ *
+ * Every row interpolates between its left and right color, four
+ * channels at a time.
+ *
+ * @param dest The bitmap to draw on.
+ * @param colors Upper-left, upper-right, lower-left and lower-right color.
+ * @param rect The rectangle to fill.
+ * @param blend YES to draw the gradient over the existing pixels, NO
+ * to replace them.
+ */
+static void amk_bitmap_gradient(amk_bitmap_t *dest, const srk_rgba_t colors[4],
+								amk_rect_t rect, BOOL blend)
+{
+	amk_float4 upperLeft = amk_float4_from_rgba(colors[AMKWindowStyleCornerUpperLeft]);
+	amk_float4 upperRight = amk_float4_from_rgba(colors[AMKWindowStyleCornerUpperRight]);
+	amk_float4 lowerLeft = amk_float4_from_rgba(colors[AMKWindowStyleCornerLowerLeft]);
+	amk_float4 lowerRight = amk_float4_from_rgba(colors[AMKWindowStyleCornerLowerRight]);
+	long width = rect.x1 - rect.x0, height = rect.y1 - rect.y0;
+
+	if(width <= 0 || height <= 0)
+		return;
+
+	for(long y = 0; y < height; ++y) {
+		srk_rgba_t *row = dest->pixels + (rect.y0 + y) * dest->width + rect.x0;
+		float ty = (height > 1) ? (float)y / (height - 1) : 0.0f;
+		amk_float4 color = upperLeft + (lowerLeft - upperLeft) * ty;
+		amk_float4 end = upperRight + (lowerRight - upperRight) * ty;
+		amk_float4 step = (width > 1) ? (end - color) / (float)(width - 1) : (amk_float4)0.0f;
+
+		if(blend) {
+			for(long x = 0; x < width; ++x, color += step) {
+				amk_float4 out, under = amk_float4_from_rgba(row[x]);
+				float alpha = color.w / 255.0f;
+				amk_uchar4 pixel;
+
+				out = color * alpha + under * (1.0f - alpha);
+				out.w = color.w + under.w * (1.0f - alpha);
+
+				pixel = __builtin_convertvector(out + 0.5f, amk_uchar4);
+				memcpy(&row[x], &pixel, sizeof(srk_rgba_t));
+			}
+		} else {
+			for(long x = 0; x < width; ++x, color += step) {
+				amk_uchar4 pixel = __builtin_convertvector(color + 0.5f, amk_uchar4);
+
+				memcpy(&row[x], &pixel, sizeof(srk_rgba_t));
+			}
+		}
+	}
+}
@@ -29,6 +29,7 @@
 #import "AMKObstructionMap.h"
 #import "AMKImage.h"
 #import "AMKSpriteSet.h"
+#import "AMKResourceCache.h"
 
 typedef struct {
 	uint8_t signature[4];
@@ -418,7 +419,8 @@ _Static_assert(sizeof(srk_rmp_zone_header_t) == 16,"wrong struct size");
 		}
 	}
 
-	// Draw entities
+	// Draw entities. Persons often share sprite sets.
+	AMKResourceCache *cache = [AMKResourceCache sharedCache];
 	for(AMKMapEntity *entity in _entities) {
 		if([entity isKindOfClass:[AMKMapTrigger class]])
 			continue;
@@ -427,7 +429,9 @@ _Static_assert(sizeof(srk_rmp_zone_header_t) == 16,"wrong struct size");
 		path = [path stringByDeletingLastPathComponent];
 		path = [path stringByAppendingPathComponent:@"spritesets"];
 		path = [path stringByAppendingPathComponent:person.spriteSetFilename];
-		AMKSpriteSet *rss = [[AMKSpriteSet alloc] initWithPath:path];
+		AMKSpriteSet *rss = [cache retainResourceOfClass:[AMKSpriteSet class] atPath:path];
+		if(rss == nil)
+			continue;
 
 		AMKSpriteSetDirection *dir = rss.directions[0];
 		AMKSpriteSetFrame *frame = dir.frames[0];
@@ -441,6 +445,8 @@ _Static_assert(sizeof(srk_rmp_zone_header_t) == 16,"wrong struct size");
 						  fromRect:NSZeroRect
 						 operation:NSCompositeSourceOver
 						  fraction:1.0];
+
+		[cache releaseResource:rss];
 	}
 
 
@@ -413,6 +413,16 @@ _Static_assert(sizeof(srk_rss_frame_v3_t) == 8,"wrong struct size");
 	return image;
 }
 
+- (NSUInteger)memoryCost
+{
+	NSUInteger cost = 0;
+
+	for(AMKImage *image in _images)
+		cost += image.rawData.length;
+
+	return cost;
+}
+
 - (BOOL)saveToFile:(NSString *)path
 {
 	NSMutableData *fileContents;
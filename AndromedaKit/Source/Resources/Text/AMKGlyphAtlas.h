@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+
+@class AMKFont, AMKImage;
+
+/// A glyph in a glyph atlas.
+typedef struct {
+	/// Size of the glyph, which is also its advance.
+	uint16_t width, height;
+	/// Position of the glyph in the atlas.
+	uint16_t x, y;
+	/// Whether the glyph has no visible pixels, like a space.
+	BOOL empty;
+} amk_glyph_t;
+
+/**
+ * @brief All glyphs of a font, packed into a single bitmap.
+ *
+ * Glyphs are placed on shelves, tallest first, with a pixel of
+ * padding between them. Empty glyphs take no space. Drawing text
+ * from an atlas only needs one texture for all characters.
+ */
+@interface AMKGlyphAtlas : NSObject
+
+/// The font the atlas was made from.
+@property (readonly) AMKFont *font;
+
+/// Size of the atlas bitmap.
+@property (readonly) NSSize size;
+
+/// Height of a line of text: the height of the tallest glyph.
+@property (readonly) unsigned int lineHeight;
+
+/// Number of glyphs in the atlas.
+@property (readonly) NSUInteger numberOfGlyphs;
+
+/// The atlas bitmap, in AMKImageFormatRGBA.
+@property (readonly) NSData *bitmapData;
+
+/// The atlas bitmap as an image. Made on first use.
+@property (readonly) AMKImage *image;
+
+/**
+ * Initialize with the glyphs of a font.
+ *
+ * @param font The font.
+ * @return self, or nil if the font has no usable glyphs.
+ */
+- (instancetype)initWithFont:(AMKFont *)font;
+
+/**
+ * Get the glyph used to draw a character.
+ *
+ * Characters the font does not have are drawn as '?'.
+ *
+ * @param character The character.
+ * @return Index of the glyph, or -1 if there is none.
+ */
+- (int)glyphForCharacter:(unichar)character;
+
+/**
+ * The glyph table.
+ *
+ * @return A table of numberOfGlyphs glyphs.
+ */
+- (const amk_glyph_t *)glyphs NS_RETURNS_INNER_POINTER;
+
+@end
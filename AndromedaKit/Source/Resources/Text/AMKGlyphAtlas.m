@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKGlyphAtlas.h"
+#import "AMKFont.h"
+#import "AMKImage.h"
+
+/// Space between glyphs, so filtering does not bleed into neighbours.
+#define AMK_GLYPH_ATLAS_PADDING 1
+
+static BOOL amk_glyph_is_empty(AMKImage *image);
+static BOOL amk_glyph_copy_pixels(AMKImage *image, srk_rgba_t *dest, size_t destWidth);
+
+@implementation AMKGlyphAtlas {
+	amk_glyph_t *_glyphs;
+	int _fallbackGlyph;
+}
+
+@synthesize image=_image;
+
+- (instancetype)initWithFont:(AMKFont *)font
+{
+	self = [super init];
+	if(self) {
+		_font = font;
+		_numberOfGlyphs = MIN(font.characters.count, UINT16_MAX);
+
+		if(_numberOfGlyphs == 0)
+			return nil;
+
+		_glyphs = calloc(_numberOfGlyphs, sizeof(amk_glyph_t));
+		if(_glyphs == NULL)
+			return nil;
+
+		_fallbackGlyph = (_numberOfGlyphs > '?') ? '?' : -1;
+
+		if(![self packGlyphs])
+			return nil;
+	}
+	return self;
+}
+
+- (void)dealloc
+{
+	free(_glyphs);
+}
+
+#pragma mark - Packing
+
+- (BOOL)packGlyphs
+{
+	NSArray *characters = _font.characters;
+	NSMutableData *bitmap;
+	srk_rgba_t *pixels;
+	uint16_t *order;
+	size_t area = 0, maxWidth = 0, atlasWidth = 64, atlasHeight;
+	size_t shelfX = 0, shelfY = 0, shelfHeight = 0;
+
+	for(NSUInteger i = 0; i < _numberOfGlyphs; ++i) {
+		AMKImage *image = characters[i];
+
+		_glyphs[i].width = image.rawSize.width;
+		_glyphs[i].height = image.rawSize.height;
+		_glyphs[i].empty = amk_glyph_is_empty(image);
+
+		_lineHeight = MAX(_lineHeight, _glyphs[i].height);
+		if(_glyphs[i].empty)
+			continue;
+
+		maxWidth = MAX(maxWidth, _glyphs[i].width + AMK_GLYPH_ATLAS_PADDING);
+		area += (_glyphs[i].width + AMK_GLYPH_ATLAS_PADDING)
+			* (_glyphs[i].height + AMK_GLYPH_ATLAS_PADDING);
+	}
+
+	// Roughly square, and a power of two wide
+	while(atlasWidth * atlasWidth < area || atlasWidth < maxWidth)
+		atlasWidth *= 2;
+
+	// Tallest glyphs first, so shelves waste little space
+	order = malloc(_numberOfGlyphs * sizeof(uint16_t));
+	if(order == NULL)
+		return NO;
+	for(NSUInteger i = 0; i < _numberOfGlyphs; ++i)
+		order[i] = i;
+	qsort_b(order, _numberOfGlyphs, sizeof(uint16_t), ^int(const void *a, const void *b) {
+		const amk_glyph_t *ga = &_glyphs[*(const uint16_t *)a];
+		const amk_glyph_t *gb = &_glyphs[*(const uint16_t *)b];
+
+		if(ga->height != gb->height)
+			return (int)gb->height - (int)ga->height;
+		return (int)*(const uint16_t *)a - (int)*(const uint16_t *)b;
+	});
+
+	for(NSUInteger i = 0; i < _numberOfGlyphs; ++i) {
+		amk_glyph_t *glyph = &_glyphs[order[i]];
+
+		if(glyph->empty)
+			continue;
+
+		if(shelfX + glyph->width + AMK_GLYPH_ATLAS_PADDING > atlasWidth) {
+			shelfY += shelfHeight + AMK_GLYPH_ATLAS_PADDING;
+			shelfX = 0;
+			shelfHeight = 0;
+		}
+
+		glyph->x = shelfX;
+		glyph->y = shelfY;
+		shelfX += glyph->width + AMK_GLYPH_ATLAS_PADDING;
+		shelfHeight = MAX(shelfHeight, glyph->height);
+	}
+	free(order);
+
+	atlasHeight = MAX(shelfY + shelfHeight, 1);
+	if(atlasHeight > UINT16_MAX) {
+		NSLog(@"Failed to create glyph atlas for %@: glyphs do not fit",_font.path);
+		return NO;
+	}
+
+	// Copy the pixels of every glyph into its spot
+	bitmap = [NSMutableData dataWithLength:atlasWidth * atlasHeight * sizeof(srk_rgba_t)];
+	pixels = bitmap.mutableBytes;
+
+	for(NSUInteger i = 0; i < _numberOfGlyphs; ++i) {
+		amk_glyph_t *glyph = &_glyphs[i];
+
+		if(glyph->empty)
+			continue;
+
+		if(!amk_glyph_copy_pixels(characters[i],
+								   pixels + glyph->y * atlasWidth + glyph->x,
+								   atlasWidth)) {
+			NSLog(@"Failed to create glyph atlas for %@: glyph %lu has an "
+				  "unsupported format",_font.path,(unsigned long)i);
+			return NO;
+		}
+	}
+
+	_size = NSMakeSize(atlasWidth, atlasHeight);
+	_bitmapData = bitmap;
+
+	return YES;
+}
+
+#pragma mark - Glyphs
+
+- (int)glyphForCharacter:(unichar)character
+{
+	if(character < _numberOfGlyphs)
+		return character;
+	return _fallbackGlyph;
+}
+
+- (const amk_glyph_t *)glyphs
+{
+	return _glyphs;
+}
+
+- (AMKImage *)image
+{
+	@synchronized(self) {
+		if(_image == nil)
+			_image = [[AMKImage alloc] initWithRawBitmapData:_bitmapData
+														size:_size
+													  format:AMKImageFormatRGBA];
+		return _image;
+	}
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"<AMKGlyphAtlas>{glyphs: %lu, size: %@, "
+			@"lineHeight: %u}",(unsigned long)_numberOfGlyphs,NSStringFromSize(_size),
+			_lineHeight];
+}
+
+@end
+
+/**
+ * Find whether an image has no visible pixels.
+ *
+ * @param image The image.
+ * @return YES if all pixels are transparent. NO otherwise, or if the
+ * format is not supported.
+ */
+static BOOL amk_glyph_is_empty(AMKImage *image)
+{
+	size_t count = image.rawSize.width * image.rawSize.height;
+	const uint8_t *src = image.rawData.bytes;
+
+	if(count == 0)
+		return YES;
+
+	switch(image.format) {
+		case AMKImageFormatRGBA:
+			if(image.rawData.length < count * sizeof(srk_rgba_t))
+				return NO;
+			for(size_t i = 0; i < count; ++i) {
+				if(((const srk_rgba_t *)src)[i].alpha != 0)
+					return NO;
+			}
+			return YES;
+		case AMKImageFormatGrayscale:
+			if(image.rawData.length < count)
+				return NO;
+			for(size_t i = 0; i < count; ++i) {
+				if(src[i] != 0)
+					return NO;
+			}
+			return YES;
+		default:
+			return NO;
+	}
+}
+
+/**
+ * Copy the pixels of an image into an RGBA bitmap.
+ *
+ * Grayscale glyphs are white, with the gray value as alpha.
+ *
+ * @param image The image.
+ * @param dest First pixel to write to.
+ * @param destWidth Width of the destination bitmap, in pixels.
+ * @return YES on success, NO if the format is not supported.
+ */
+static BOOL amk_glyph_copy_pixels(AMKImage *image, srk_rgba_t *dest, size_t destWidth)
+{
+	size_t width = image.rawSize.width, height = image.rawSize.height;
+	const uint8_t *src = image.rawData.bytes;
+	size_t length = image.rawData.length;
+
+	switch(image.format) {
+		case AMKImageFormatRGBA:
+			if(length < width * height * sizeof(srk_rgba_t))
+				return NO;
+			for(size_t y = 0; y < height; ++y)
+				memcpy(dest + y * destWidth, src + y * width * sizeof(srk_rgba_t),
+					   width * sizeof(srk_rgba_t));
+			return YES;
+		case AMKImageFormatGrayscale:
+			if(length < width * height)
+				return NO;
+			for(size_t y = 0; y < height; ++y) {
+				for(size_t x = 0; x < width; ++x) {
+					srk_rgba_t *pixel = &dest[y * destWidth + x];
+
+					pixel->red = pixel->green = pixel->blue = 255;
+					pixel->alpha = src[y * width + x];
+				}
+			}
+			return YES;
+		default:
+			return NO;
+	}
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+@class AMKFont, AMKGlyphAtlas, AMKTextLayout;
+
+/**
+ * @brief Lays out and measures text in a font.
+ *
+ * Owns the glyph atlas of the font and a cache of layouts, keyed by
+ * string and wrap width. Screens that draw the same text every frame
+ * get the same layout back without measuring again.
+ */
+@interface AMKTextEngine : NSObject
+
+/// The font.
+@property (readonly) AMKFont *font;
+
+/// The glyph atlas of the font.
+@property (readonly) AMKGlyphAtlas *atlas;
+
+/// Maximum number of layouts kept in the cache. Defaults to 256.
+@property (assign,nonatomic) NSUInteger layoutCacheLimit;
+
+/**
+ * Initialize with a font.
+ *
+ * @param font The font.
+ * @return self, or nil if no atlas could be made for the font.
+ */
+- (instancetype)initWithFont:(AMKFont *)font;
+
+/**
+ * Get the layout of a string.
+ *
+ * @param string The string.
+ * @param width The width to wrap lines at, or 0 to not wrap.
+ * @return A layout, possibly from the cache.
+ */
+- (AMKTextLayout *)layoutForString:(NSString *)string width:(CGFloat)width;
+
+/**
+ * Measure a string.
+ *
+ * @param string The string.
+ * @param width The width to wrap lines at, or 0 to not wrap.
+ * @return The size of the laid out string.
+ */
+- (NSSize)sizeOfString:(NSString *)string width:(CGFloat)width;
+
+/**
+ * Remove all layouts from the cache.
+ */
+- (void)removeAllCachedLayouts;
+
+@end
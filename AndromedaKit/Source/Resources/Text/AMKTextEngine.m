@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKTextEngine.h"
+#import "AMKGlyphAtlas.h"
+#import "AMKTextLayout.h"
+
+/**
+ * @brief Key of the layout cache.
+ */
+@interface AMKTextLayoutKey : NSObject <NSCopying>
+@property (readonly) NSString *string;
+@property (readonly) CGFloat width;
+- (instancetype)initWithString:(NSString *)string width:(CGFloat)width;
+@end
+
+@implementation AMKTextLayoutKey
+
+- (instancetype)initWithString:(NSString *)string width:(CGFloat)width
+{
+	self = [super init];
+	if(self) {
+		_string = [string copy];
+		_width = width;
+	}
+	return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	return self;
+}
+
+- (NSUInteger)hash
+{
+	return _string.hash ^ (NSUInteger)_width;
+}
+
+- (BOOL)isEqual:(id)object
+{
+	AMKTextLayoutKey *other = object;
+
+	if(![object isKindOfClass:[AMKTextLayoutKey class]])
+		return NO;
+	return other.width == _width && [other.string isEqualToString:_string];
+}
+
+@end
+
+@implementation AMKTextEngine {
+	NSCache *_layoutCache;
+}
+
+- (instancetype)initWithFont:(AMKFont *)font
+{
+	self = [super init];
+	if(self) {
+		_font = font;
+
+		_atlas = [[AMKGlyphAtlas alloc] initWithFont:font];
+		if(_atlas == nil)
+			return nil;
+
+		_layoutCache = [[NSCache alloc] init];
+		self.layoutCacheLimit = 256;
+	}
+	return self;
+}
+
+- (void)setLayoutCacheLimit:(NSUInteger)layoutCacheLimit
+{
+	_layoutCacheLimit = layoutCacheLimit;
+	_layoutCache.countLimit = layoutCacheLimit;
+}
+
+- (AMKTextLayout *)layoutForString:(NSString *)string width:(CGFloat)width
+{
+	AMKTextLayoutKey *key;
+	AMKTextLayout *layout;
+
+	if(string == nil)
+		string = @"";
+	width = MAX(width, 0);
+
+	key = [[AMKTextLayoutKey alloc] initWithString:string width:width];
+	layout = [_layoutCache objectForKey:key];
+	if(layout == nil) {
+		layout = [[AMKTextLayout alloc] initWithString:string
+												 width:width
+												 atlas:_atlas];
+		if(layout != nil)
+			[_layoutCache setObject:layout forKey:key];
+	}
+
+	return layout;
+}
+
+- (NSSize)sizeOfString:(NSString *)string width:(CGFloat)width
+{
+	return [self layoutForString:string width:width].size;
+}
+
+- (void)removeAllCachedLayouts
+{
+	[_layoutCache removeAllObjects];
+}
+
+@end
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+@class AMKGlyphAtlas;
+
+/// A textured rectangle that draws one glyph.
+typedef struct {
+	/// Position and size on screen.
+	float x, y, width, height;
+	/// Texture coordinates in the glyph atlas, from 0 to 1.
+	float u0, v0, u1, v1;
+} amk_text_quad_t;
+
+/**
+ * @brief A string laid out with a font.
+ *
+ * Lines are broken at newlines and, when a width is set, wrapped at
+ * spaces. Words longer than the width are broken between characters.
+ * The glyphs are stored as quads relative to the top-left corner of
+ * the text, so drawing the same text again only moves them.
+ *
+ * Layouts are immutable.
+ */
+@interface AMKTextLayout : NSObject
+
+/// The laid out string.
+@property (readonly) NSString *string;
+
+/// The width lines are wrapped at. 0 when not wrapping.
+@property (readonly) CGFloat width;
+
+/// Size of the text: the widest line by the height of all lines.
+@property (readonly) NSSize size;
+
+/// Number of lines.
+@property (readonly) NSUInteger numberOfLines;
+
+/// Number of quads: glyphs that have visible pixels.
+@property (readonly) NSUInteger numberOfQuads;
+
+/**
+ * Lay out a string.
+ *
+ * @param string The string.
+ * @param width The width to wrap lines at, or 0 to not wrap.
+ * @param atlas The glyph atlas of the font.
+ * @return self
+ */
+- (instancetype)initWithString:(NSString *)string
+						 width:(CGFloat)width
+						 atlas:(AMKGlyphAtlas *)atlas;
+
+/**
+ * The quads of the text, relative to its top-left corner.
+ *
+ * @return A list of numberOfQuads quads.
+ */
+- (const amk_text_quad_t *)quads NS_RETURNS_INNER_POINTER;
+
+/**
+ * Write the quads of the text, moved to a point.
+ *
+ * Used to fill a vertex batch with several texts.
+ *
+ * @param quads Buffer to write to.
+ * @param capacity Number of quads that fit in the buffer.
+ * @param point Where to put the top-left corner of the text.
+ * @return The number of quads written.
+ */
+- (NSUInteger)getQuads:(amk_text_quad_t *)quads
+			  capacity:(NSUInteger)capacity
+			   atPoint:(NSPoint)point;
+
+@end
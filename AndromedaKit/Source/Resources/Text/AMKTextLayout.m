@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2014 Jos Kuijpers. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#import "AMKTextLayout.h"
+#import "AMKGlyphAtlas.h"
+
+@implementation AMKTextLayout {
+	amk_text_quad_t *_quads;
+}
+
+- (instancetype)initWithString:(NSString *)string
+						 width:(CGFloat)width
+						 atlas:(AMKGlyphAtlas *)atlas
+{
+	self = [super init];
+	if(self) {
+		_string = [string copy];
+		_width = MAX(width, 0);
+
+		if(![self layOutWithAtlas:atlas])
+			return nil;
+	}
+	return self;
+}
+
+- (void)dealloc
+{
+	free(_quads);
+}
+
+- (BOOL)layOutWithAtlas:(AMKGlyphAtlas *)atlas
+{
+	const amk_glyph_t *glyphs = atlas.glyphs;
+	float lineHeight = atlas.lineHeight;
+	float atlasWidth = atlas.size.width, atlasHeight = atlas.size.height;
+	NSUInteger length = _string.length, breakQuad = NSNotFound;
+	float x = 0, y = 0, contentX = 0, maxWidth = 0, breakX = 0, breakContentX = 0;
+	BOOL wrap = (_width > 0);
+	unichar *characters;
+
+	characters = malloc(MAX(length, 1) * sizeof(unichar));
+	_quads = malloc(MAX(length, 1) * sizeof(amk_text_quad_t));
+	if(characters == NULL || _quads == NULL) {
+		free(characters);
+		return NO;
+	}
+	[_string getCharacters:characters range:NSMakeRange(0, length)];
+
+	// x is the pen position, contentX the end of the last non-space glyph
+	// on the line: trailing spaces do not count towards the width.
+	_numberOfLines = 1;
+	for(NSUInteger i = 0; i < length; ++i) {
+		unichar c = characters[i];
+		const amk_glyph_t *glyph;
+		int index;
+
+		if(c == '\n' || c == '\r') {
+			if(c == '\r' && i + 1 < length && characters[i + 1] == '\n')
+				continue;
+
+			maxWidth = MAX(maxWidth, contentX);
+			x = contentX = 0;
+			y += lineHeight;
+			_numberOfLines++;
+			breakQuad = NSNotFound;
+			continue;
+		}
+
+		if((index = [atlas glyphForCharacter:c]) < 0)
+			continue;
+		glyph = &glyphs[index];
+
+		if(wrap && x > 0 && x + glyph->width > _width) {
+			if(breakQuad != NSNotFound && c != ' ') {
+				// Move the word being written to the next line
+				maxWidth = MAX(maxWidth, breakContentX);
+				for(NSUInteger q = breakQuad; q < _numberOfQuads; ++q) {
+					_quads[q].x -= breakX;
+					_quads[q].y += lineHeight;
+				}
+				x -= breakX;
+				contentX = MAX(contentX - breakX, 0);
+			} else {
+				maxWidth = MAX(maxWidth, contentX);
+				x = contentX = 0;
+			}
+
+			y += lineHeight;
+			_numberOfLines++;
+			breakQuad = NSNotFound;
+
+			// Spaces at the wrap are dropped
+			if(c == ' ' && x == 0)
+				continue;
+
+			// The word is wider than a line: break it between characters
+			if(x > 0 && x + glyph->width > _width) {
+				maxWidth = MAX(maxWidth, contentX);
+				x = contentX = 0;
+				y += lineHeight;
+				_numberOfLines++;
+			}
+		}
+
+		if(!glyph->empty) {
+			amk_text_quad_t *quad = &_quads[_numberOfQuads++];
+
+			quad->x = x;
+			quad->y = y;
+			quad->width = glyph->width;
+			quad->height = glyph->height;
+			quad->u0 = glyph->x / atlasWidth;
+			quad->v0 = glyph->y / atlasHeight;
+			quad->u1 = (glyph->x + glyph->width) / atlasWidth;
+			quad->v1 = (glyph->y + glyph->height) / atlasHeight;
+		}
+
+		x += glyph->width;
+
+		if(c == ' ') {
+			breakQuad = _numberOfQuads;
+			breakX = x;
+			breakContentX = contentX;
+		} else
+			contentX = x;
+	}
+	free(characters);
+
+	maxWidth = MAX(maxWidth, contentX);
+	_size = NSMakeSize(maxWidth, _numberOfLines * lineHeight);
+
+	// Layouts are kept in caches: do not hold on to unused space
+	if(_numberOfQuads < length) {
+		amk_text_quad_t *quads;
+
+		quads = realloc(_quads, MAX(_numberOfQuads, 1) * sizeof(amk_text_quad_t));
+		if(quads != NULL)
+			_quads = quads;
+	}
+
+	return YES;
+}
+
+- (const amk_text_quad_t *)quads
+{
+	return _quads;
+}
+
+- (NSUInteger)getQuads:(amk_text_quad_t *)quads
+			  capacity:(NSUInteger)capacity
+			   atPoint:(NSPoint)point
+{
+	NSUInteger count = MIN(capacity, _numberOfQuads);
+
+	for(NSUInteger i = 0; i < count; ++i) {
+		quads[i] = _quads[i];
+		quads[i].x += point.x;
+		quads[i].y += point.y;
+	}
+
+	return count;
+}
+
+- (NSString *)description
+{
+	return [NSString stringWithFormat:@"<AMKTextLayout>{size: %@, lines: %lu, quads: %lu}",
+			NSStringFromSize(_size),(unsigned long)_numberOfLines,
+			(unsigned long)_numberOfQuads];
+}
+
+@end